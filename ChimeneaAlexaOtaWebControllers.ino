@@ -3,37 +3,85 @@
 #include "alexa_manager.h"
 #include "led_manager.h"
 #include "web_manager.h"
+#include "settings_manager.h"
+#include "network_task.h"
+#include "system_telemetry.h"
 
 
-OTAManager otaManager;
 LedManager ledManager;
+OTAManager otaManager(&ledManager);
 AlexaManager alexaManager(&ledManager);
 WebManager webManager(&ledManager);
+SettingsManager settingsManager(&ledManager);
+NetworkTask networkTask;
+SystemTelemetry telemetry;
+
+// Los cambios esperan SETTINGS_SAVE_DELAY antes de ir a NVS; cualquier
+// reinicio los guarda antes. Corre en la tarea de red, igual que handle()
+void flushSettings() {
+    settingsManager.flush();
+}
+
+// Servicios de red: se levantan cuando la primera conexión WiFi está lista.
+// Web y Alexa comparten un solo AsyncWebServer en HTTP_PORT.
+void startNetworkServices() {
+    const uint32_t heapBefore = ESP.getFreeHeap();
+
+    // Hora del sistema por SNTP (la usa el texto superpuesto)
+    configTime(CLOCK_UTC_OFFSET, 0, NTP_SERVER);
+
+    webManager.setSettingsManager(&settingsManager);
+    webManager.setNetworkTask(&networkTask);
+    webManager.onBeforeRestart(flushSettings);
+    webManager.setApiFallback([](AsyncWebServerRequest* request) {
+        return alexaManager.handleApiCall(request);
+    });
+    webManager.begin();
+    alexaManager.begin(webManager.getServer());
+    telemetry.registerRoutes(webManager.getServer());
+
+    Serial.printf("Heap usado por web + Alexa: %u bytes (libre: %u)\n",
+                  heapBefore - ESP.getFreeHeap(), ESP.getFreeHeap());
+}
 
 void setup() {
-    Serial.begin(115200);
-
-    // Inicializar WiFi
-    WiFi.mode(WIFI_STA);
-    WiFi.begin(ssid, password);
-    while (WiFi.status() != WL_CONNECTED) {
-        delay(500);
-        Serial.print(".");
-    }
-    Serial.println("\nWiFi connected");
-    Serial.print("IP address: ");
-    Serial.println(WiFi.localIP());
+    Serial.begin(SERIAL_BAUD_RATE);
+    BootTimeline::instance().mark(BOOT_SETUP);
 
-    otaManager.begin();
+    // Restaurar la configuración y arrancar los LEDs antes que la red
+    settingsManager.begin();
     ledManager.begin();
-    webManager.begin();
-    alexaManager.begin();
-    
-    ledManager.setEffect(FIRE);
+
+    // Todo lo de red corre en su propia tarea; loop() solo renderiza.
+    // Los sockets se sondean en cada despertar y el resto va en la rueda.
+    networkTask.poll("ota", []() { otaManager.handle(); });
+    networkTask.poll("alexa", []() { alexaManager.handle(); });
+    networkTask.every("web", NETWORK_SERVICE_INTERVAL, []() { webManager.handle(); });
+    networkTask.every("settings", NETWORK_SERVICE_INTERVAL, []() { settingsManager.handle(); });
+    networkTask.every("wifi", WIFI_CHECK_INTERVAL, []() { otaManager.checkWiFi(); });
+    networkTask.every("telemetry", TELEMETRY_SAMPLE_INTERVAL, []() { telemetry.sample(); });
+    networkTask.every("info", SYSTEM_INFO_INTERVAL, []() {
+        otaManager.printSystemInfo();
+        networkTask.printStats();
+    });
+
+    // Los eventos WiFi despiertan la tarea sin esperar al siguiente sondeo
+    otaManager.onWiFiEvent([]() { networkTask.notify(); });
+    otaManager.onFirstConnection(startNetworkServices);
+    otaManager.onBeforeRestart(flushSettings);
+    otaManager.begin();
+    networkTask.begin();
+
+    telemetry.trackTask("loopTask");
+    telemetry.trackTask("network");
+    telemetry.trackTask("output");
+    telemetry.trackTask("preview");
+    telemetry.trackTask("verse");
+    telemetry.trackTask("async_tcp");
+    telemetry.begin();
 }
 
 void loop() {
-    otaManager.handle();
-    alexaManager.handle();
+    telemetry.countLoop();
     ledManager.handle();
 }
\ No newline at end of file
@@ -1,9 +1,12 @@
 #ifndef ALEXA_MANAGER_H
 #define ALEXA_MANAGER_H
 
+// Espalexa usa el AsyncWebServer de WebManager en lugar de levantar el suyo
+#define ESPALEXA_ASYNC
 #include <Espalexa.h>
 #include "config.h"
 #include "led_manager.h"
+#include "boot_timeline.h"
 
 class AlexaManager {
 private:
@@ -11,32 +14,44 @@ private:
     LedManager* ledManager;
     bool deviceState;
     int brightness;
+    bool started;
 
-    static void mainDeviceChanged(uint8_t brightness) {
-        extern LedManager ledManager;
-        
+    void mainDeviceChanged(uint8_t brightness) {
         if (brightness) {
             Serial.print("Alexa encendió el dispositivo. Brillo: ");
             Serial.println(brightness);
-            ledManager.setState(true);
-            ledManager.setBrightness(brightness);
+            ledManager->setState(true);
+            ledManager->setBrightness(brightness);
         }
         else {
             Serial.println("Alexa apagó el dispositivo");
-            ledManager.setState(false);
+            ledManager->setState(false);
         }
     }
 
 public:
     AlexaManager(LedManager* ledMgr) 
-        : deviceState(false), brightness(0), ledManager(ledMgr) {}
+        : ledManager(ledMgr), deviceState(false), brightness(0), started(false) {}
 
-    void begin() {
-        espalexa.addDevice(ALEXA_DEVICE_NAME, mainDeviceChanged);
-        espalexa.begin();
+    // Monta las rutas de descubrimiento en el servidor compartido
+    void begin(AsyncWebServer& server) {
+        espalexa.addDevice(ALEXA_DEVICE_NAME, [this](uint8_t brightness) {
+            mainDeviceChanged(brightness);
+        });
+        espalexa.begin(&server);
+        started = true;
+        BootTimeline::instance().mark(BOOT_ALEXA_READY);
+    }
+
+    // Devuelve true si la petición era de Alexa y ya fue respondida
+    bool handleApiCall(AsyncWebServerRequest* request) {
+        if (!started) return false;
+        return espalexa.handleAlexaApiCall(request);
     }
 
     void handle() {
+        // Alexa se levanta cuando hay WiFi; antes de eso no hay nada que atender
+        if (!started) return;
         espalexa.loop();
     }
 
@@ -0,0 +1,85 @@
+#ifndef BOOT_TIMELINE_H
+#define BOOT_TIMELINE_H
+
+#include <Arduino.h>
+
+// Hitos del arranque, en el orden esperado
+enum BootEvent {
+    BOOT_SETUP,
+    BOOT_SETTINGS_RESTORED,
+    BOOT_FIRST_FRAME,
+    BOOT_WIFI_CONNECTED,
+    BOOT_OTA_READY,
+    BOOT_WEB_READY,
+    BOOT_ALEXA_READY,
+    BOOT_FIRST_HTTP_RESPONSE,
+    BOOT_EVENT_COUNT
+};
+
+// Registro de tiempos de arranque (ms desde el reinicio). Cada hito se
+// guarda solo la primera vez que ocurre.
+class BootTimeline {
+private:
+    unsigned long timestamps[BOOT_EVENT_COUNT];
+    bool recorded[BOOT_EVENT_COUNT];
+
+    BootTimeline() {
+        for (uint8_t i = 0; i < BOOT_EVENT_COUNT; i++) {
+            timestamps[i] = 0;
+            recorded[i] = false;
+        }
+    }
+
+public:
+    static BootTimeline& instance() {
+        static BootTimeline timeline;
+        return timeline;
+    }
+
+    static const char* eventName(BootEvent event) {
+        switch (event) {
+            case BOOT_SETUP: return "setup";
+            case BOOT_SETTINGS_RESTORED: return "settings";
+            case BOOT_FIRST_FRAME: return "firstFrame";
+            case BOOT_WIFI_CONNECTED: return "wifi";
+            case BOOT_OTA_READY: return "ota";
+            case BOOT_WEB_READY: return "web";
+            case BOOT_ALEXA_READY: return "alexa";
+            case BOOT_FIRST_HTTP_RESPONSE: return "firstHttpResponse";
+            default: return "unknown";
+        }
+    }
+
+    void mark(BootEvent event) {
+        if (recorded[event]) return;
+        timestamps[event] = millis();
+        recorded[event] = true;
+        Serial.printf("[boot] %s: %lu ms\n", eventName(event), timestamps[event]);
+
+        if (event == BOOT_FIRST_HTTP_RESPONSE) {
+            print();
+        }
+    }
+
+    bool has(BootEvent event) const {
+        return recorded[event];
+    }
+
+    unsigned long get(BootEvent event) const {
+        return timestamps[event];
+    }
+
+    void print() const {
+        Serial.println("\n--- Línea de tiempo de arranque ---");
+        for (uint8_t i = 0; i < BOOT_EVENT_COUNT; i++) {
+            if (recorded[i]) {
+                Serial.printf("%-18s %6lu ms\n", eventName(static_cast<BootEvent>(i)), timestamps[i]);
+            } else {
+                Serial.printf("%-18s      -\n", eventName(static_cast<BootEvent>(i)));
+            }
+        }
+        Serial.println("-----------------------------------\n");
+    }
+};
+
+#endif
@@ -9,10 +9,13 @@ const char* password = "E4A7E89Fn4vAVM78";
 const char* OTA_HOSTNAME = "Chimenea-OTA";
 const char* OTA_PASSWORD = "admin3765";
 const int OTA_PORT = 3232;
+const char* OTA_USERNAME = "admin";                     // Usuario para /api/firmware
+const unsigned long FIRMWARE_UPLOAD_TIMEOUT = 15000;    // Subida HTTP abandonada tras 15 s sin datos
+const unsigned long FIRMWARE_RESTART_DELAY = 1000;      // Espera antes de reiniciar tras actualizar
 
 // Configuración Alexa
 const char* ALEXA_DEVICE_NAME = "LED Prueba";
-const int ALEXA_PORT = 80;  
+const int HTTP_PORT = 80;   // Servidor compartido por la interfaz web y Alexa
 
 // Configuración LED WS2812B
 const int LED_PIN = 2;           // Pin de datos para WS2812B
@@ -21,15 +24,115 @@ const int LED_PIN = 2;           // Pin de datos para WS2812B
 //const int NUM_LEDS = LED_WIDTH * LED_HEIGHT;  // Total de LEDs
 const int NUM_LEDS = 702;
 const int MAX_BRIGHTNESS = 200;   // Brillo máximo
+const bool MATRIX_IS_RING = true; // La matriz rodea el fogón (columna 26 junto a la 0)
+
+// Modelo de consumo (ver power_limiter.h)
+const uint16_t POWER_BUDGET_MA = 8000;   // Corriente que la fuente puede dar a los LEDs
+const uint8_t LED_VOLTAGE = 5;
+const uint8_t LED_RED_MA = 16;           // Corriente de cada canal a 255
+const uint8_t LED_GREEN_MA = 11;
+const uint8_t LED_BLUE_MA = 15;
+const uint8_t LED_IDLE_MA = 1;           // Consumo de cada LED apagado
+const uint8_t POWER_RELEASE_STEP = 2;    // Brillo que el límite recupera por frame
+
+// Salida de alta profundidad (ver output_pipeline.h)
+const bool HIGH_DEPTH_OUTPUT = true;     // Brillo en 16 bits con dithering temporal
+const float OUTPUT_GAMMA = 1.0f;         // 1.0 conserva los colores calibrados de los efectos
+
+// Desenfoque y resplandor por efecto (ver post_fx.h)
+const uint8_t MAX_BLUR_RADIUS = 4;       // La suma corrida cuesta lo mismo con cualquier radio
+const uint8_t BLUR_RADIUS = 1;           // Radio por omisión
+const uint8_t BLOOM_THRESHOLD = 160;     // Nivel de canal a partir del cual brilla
+
+// Hora (reloj y texto superpuesto, ver text_overlay.h)
+const char* const NTP_SERVER = "pool.ntp.org";
+const long CLOCK_UTC_OFFSET = -6 * 3600;  // UTC-6 para CDMX
+const uint32_t MIN_VALID_EPOCH = 1600000000; // Antes de esto el reloj aún no se sincronizó
+const uint8_t OVERLAY_ROW = 17;           // Fila inferior de la caja del texto
+const uint8_t OVERLAY_SHADOW_ALPHA = 192; // Cuánto se oscurece el fondo alrededor de las letras
+const uint16_t SCROLL_STRIP_COLUMNS = 2048; // Columnas rasterizadas del versículo (~500 letras)
+const uint8_t SCROLL_SPEED = 10;          // Columnas por segundo
+const uint8_t SCROLL_BAND_ALPHA = 128;    // Sombra de la franja por donde pasa el versículo
+const unsigned long VERSE_RETRY_INTERVAL = 60000; // Espera tras una descarga fallida del versículo
+const unsigned long VERSE_UPDATE_INTERVAL = 3600000; // Vigencia del versículo descargado (1 hora)
 
 // Intervalos de tiempo (en millisegundos)
 const long WIFI_CHECK_INTERVAL = 30000;     // Intervalo para verificar WiFi (30 segundos)
-const int WIFI_RETRY_DELAY = 5000;          // Tiempo entre intentos de reconexión (5 segundos)
+const unsigned long WIFI_RETRY_DELAY = 5000;      // Espera inicial entre intentos de reconexión (5 segundos)
+const unsigned long WIFI_MAX_RETRY_DELAY = 60000; // Espera máxima tras duplicar en cada intento (1 minuto)
 const long SYSTEM_INFO_INTERVAL = 300000;   // Intervalo para imprimir info del sistema (5 minutos)
 const int ERROR_RETRY_DELAY = 5000;         // Tiempo antes de reiniciar por error (5 segundos)
 
+// Memoria de trabajo del efecto activo (ver effect_arena.h)
+const size_t EFFECT_ARENA_BUDGET = 1024;          // Bytes máximos que puede ocupar un efecto
+const size_t RENDER_MEMORY_BUDGET = 23552;        // Bytes máximos de LedManager: frames, dos buffers de salida, arenas, capas y métricas
+const uint8_t OVERLAY_LAYERS = 2;                 // Capas sobre el efecto base (ver effect_layers.h)
+
+// Buffers de texto de capacidad fija (ver fixed_string.h)
+const size_t VERSE_TEXT_CAPACITY = 480;           // Texto del versículo del día
+const size_t VERSE_REFERENCE_CAPACITY = 48;       // Referencia "Libro capítulo:versículo"
+const size_t OVERLAY_TEXT_CAPACITY = 32;          // Texto superpuesto a los efectos
+const size_t TRANSLATE_URL_CAPACITY = 1536;      // Petición de traducción con el texto codificado
+
+// Telemetría del sistema (/api/system)
+const unsigned long TELEMETRY_SAMPLE_INTERVAL = 5000; // Intervalo entre muestras
+const uint16_t TELEMETRY_HISTORY = 60;            // Muestras guardadas (5 minutos)
+
+// Planificador de frames (ver frame_scheduler.h)
+const unsigned long FRAME_INTERVAL_US = 22000;    // ~45 FPS; show() de 702 LEDs tarda ~21 ms (en paralelo, ver led_output.h)
+const uint8_t MAX_FRAME_LAG = 3;                  // Frames de atraso antes de saltarlos
+const uint8_t MAX_STEPS_PER_FRAME = 4;            // Pasos de simulación máximos por frame
+const uint8_t QUALITY_WINDOW = 32;                // Frames evaluados antes de cambiar de calidad
+const uint8_t QUALITY_MISS_LIMIT = 4;             // Atrasos por ventana que bajan la calidad
+const uint8_t QUALITY_RECOVERY_WINDOWS = 8;       // Ventanas limpias seguidas para volver a subir
+
+// Transiciones entre efectos
+const uint16_t EFFECT_TRANSITION_MS = 800;        // Fundido por omisión al cambiar de efecto
+const uint16_t MAX_EFFECT_TRANSITION_MS = 5000;   // Máximo aceptado por /api/transition
+
+// Rampas de brillo, tono y saturación (ver param_ramp.h)
+const uint16_t PARAM_RAMP_MS = 300;               // Duración por omisión de un cambio
+const uint16_t MAX_PARAM_RAMP_MS = 10000;         // Máximo aceptado por la API
+
+// Métricas de frame (/api/metrics)
+const unsigned long LED_WIRE_US = NUM_LEDS * 30 + 280;   // FastLED.show(): 30 us por LED más el reset
+const unsigned long FRAME_DEADLINE_US = FRAME_INTERVAL_US * 9 / 10; // Render y entrega por frame; más es atraso
+static_assert(LED_WIRE_US < FRAME_INTERVAL_US, "El envío de un frame debe caber en FRAME_INTERVAL_US");
+
+// Configuración persistente (NVS)
+const unsigned long SETTINGS_SAVE_DELAY = 5000;   // Espera sin cambios antes de guardar
+const unsigned long SETTINGS_MAX_DELAY = 30000;   // Máximo tiempo con cambios sin guardar
+
+// Configuración de la vista previa (WebSocket)
+const unsigned long PREVIEW_INTERVAL = 100;       // Intervalo entre frames de vista previa (10 FPS)
+const unsigned long PREVIEW_MAX_INTERVAL = 1000;  // Intervalo máximo cuando el codificador se atrasa
+const unsigned long PREVIEW_IDLE_DELAY = 500;     // Espera cuando no hay clientes conectados
+const unsigned long PREVIEW_CPU_BUDGET_US = 2000; // Presupuesto de CPU por frame codificado
+const int PREVIEW_SNAPSHOT_TIMEOUT = 50;          // Ticks máximos esperando la copia del render
+const int PREVIEW_KEYFRAME_INTERVAL = 50;         // Frames entre keyframes completos
+const int PREVIEW_TASK_CORE = 0;                  // Núcleo de la tarea de codificación
+const int PREVIEW_TASK_STACK = 4096;              // Tamaño de pila de la tarea
+const size_t PREVIEW_MEMORY_BUDGET = 7680;        // Bytes máximos de PreviewStream (dos frames y el paquete)
+
+// Tarea de red (OTA, Alexa, web y tareas periódicas)
+const unsigned long NETWORK_POLL_INTERVAL = 10;   // Espera máxima entre sondeos de sockets
+const unsigned long NETWORK_SERVICE_INTERVAL = 250; // Periodo de servicios web y de configuración
+const uint16_t TIMER_WHEEL_TICK = 100;            // Resolución de la rueda de temporizadores
+const unsigned long NETWORK_STATS_INTERVAL = 10000; // Ventana de medición de carga por servicio
+const int NETWORK_TASK_CORE = 0;                  // Núcleo de la tarea de red
+const int NETWORK_TASK_STACK = 8192;              // Tamaño de pila de la tarea
+
+// Tarea de salida a los LEDs (ver led_output.h)
+const int LED_OUTPUT_TASK_CORE = 1;               // El mismo núcleo que el render
+const int LED_OUTPUT_TASK_STACK = 2048;           // Solo llama a FastLED.show()
+const int LED_OUTPUT_TASK_PRIORITY = 2;           // Sobre loopTask: toma cada frame en cuanto se entrega
+
+// Tarea del versículo del día (TLS y traducción, fuera de la tarea de red)
+const int VERSE_TASK_CORE = 0;                    // Núcleo de la tarea de descarga
+const int VERSE_TASK_STACK = 8192;                // TLS necesita más pila que el resto
+const int VERSE_TASK_PRIORITY = 0;                // Por debajo de la red: solo usa el CPU libre
+
 // Parámetros de configuración
-const int MAX_WIFI_RETRIES = 5;             // Número máximo de intentos de reconexión WiFi
 const int SERIAL_BAUD_RATE = 115200;        // Velocidad del puerto serial
 
 // Estados del dispositivo
@@ -57,6 +160,14 @@ enum LedEffect {
     OFF
 };
 
+// Niveles de calidad de los efectos. El FrameScheduler baja de nivel cuando
+// los frames exceden su plazo de forma sostenida y sube cuando sobra margen.
+enum QualityTier : uint8_t {
+    QUALITY_FULL,
+    QUALITY_REDUCED,  // Versión más barata del efecto
+    QUALITY_TIER_COUNT
+};
+
 // Mensajes del sistema (facilita la internacionalización)
 namespace SystemMessages {
     const char* const STARTING = "Iniciando sistema...";
@@ -90,6 +201,10 @@ namespace SystemInfo {
     const char* const MAC_FORMAT = "MAC Address: %s\n";
     const char* const RSSI_FORMAT = "RSSI: %d dBm\n";
     const char* const UPTIME_FORMAT = "Tiempo encendido: %lu segundos\n";
+    const char* const RECONNECT_FORMAT = "Reconexiones WiFi: %u (intentos: %u)\n";
+    const char* const OUTAGE_TOTAL_FORMAT = "Tiempo sin WiFi: %lu ms (máximo: %lu ms)\n";
+    const char* const OTA_STATS_FORMAT = "OTA: %u bytes en %lu ms (%lu KB/s)\n";
+    const char* const OUTAGE_FORMAT = "Sin WiFi durante %lu ms (%u intentos acumulados)\n";
 }
 
 #endif // CONFIG_H
\ No newline at end of file
@@ -0,0 +1,220 @@
+#ifndef DAILY_VERSE_H
+#define DAILY_VERSE_H
+
+#include <WiFiClientSecure.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "led_manager.h"
+#include "fixed_string.h"
+
+// Versículo del día traducido al español. La descarga (una petición TLS y
+// dos traducciones) tarda segundos, así que corre en su propia tarea de
+// baja prioridad y es la única que la hace; la tarea de red y los
+// manejadores HTTP solo piden que se actualice y leen la copia publicada,
+// que se reemplaza completa bajo un mutex.
+class DailyVerse {
+private:
+    LedManager* ledManager;
+    TaskHandle_t taskHandle;
+    SemaphoreHandle_t lock;
+
+    // Publicado: se lee y se escribe con el mutex tomado
+    FixedString<VERSE_TEXT_CAPACITY> publishedVerse;
+    FixedString<VERSE_REFERENCE_CAPACITY> publishedReference;
+
+    // Área de trabajo de la tarea (nadie más la toca)
+    FixedString<VERSE_TEXT_CAPACITY> fetchedVerse;
+    FixedString<VERSE_REFERENCE_CAPACITY> fetchedReference;
+    FixedString<VERSE_REFERENCE_CAPACITY> translatedBook;
+    FixedString<TRANSLATE_URL_CAPACITY> translateRequest;
+    uint8_t fetchedBook;
+    uint8_t fetchedChapter;
+    uint8_t fetchedVerseNumber;
+
+    volatile unsigned long lastUpdate;   // Última descarga correcta
+    volatile unsigned long lastAttempt;
+    volatile bool hasVerse;
+    volatile bool attempted;
+
+    static uint8_t getBookNumber(const char* bookName) {
+        static const char* const BOOK_NAMES[] = {
+            "Genesis", "Exodus", "Leviticus", "Numbers", "Deuteronomy",
+            "Joshua", "Judges", "Ruth", "1 Samuel", "2 Samuel",
+            "1 Kings", "2 Kings", "1 Chronicles", "2 Chronicles",
+            "Ezra", "Nehemiah", "Esther", "Job", "Psalms", "Proverbs",
+            "Ecclesiastes", "Song of Solomon", "Isaiah", "Jeremiah",
+            "Lamentations", "Ezekiel", "Daniel", "Hosea", "Joel", "Amos",
+            "Obadiah", "Jonah", "Micah", "Nahum", "Habakkuk", "Zephaniah",
+            "Haggai", "Zechariah", "Malachi",
+            "Matthew", "Mark", "Luke", "John", "Acts", "Romans",
+            "1 Corinthians", "2 Corinthians", "Galatians", "Ephesians",
+            "Philippians", "Colossians", "1 Thessalonians", "2 Thessalonians",
+            "1 Timothy", "2 Timothy", "Titus", "Philemon", "Hebrews",
+            "James", "1 Peter", "2 Peter", "1 John", "2 John", "3 John",
+            "Jude", "Revelation"
+        };
+
+        for (uint8_t i = 0; i < 66; i++) {
+            if (strcmp(bookName, BOOK_NAMES[i]) == 0) {
+                return i + 1;  // Los números de libro empiezan en 1
+            }
+        }
+        return 1;  // Por defecto, retorna 1 (Genesis)
+    }
+
+    // Saltar las cabeceras HTTP; el cuerpo se lee directo del socket
+    static bool skipHeaders(Stream& client) {
+        return client.find("\r\n\r\n");
+    }
+
+    // Sin versículo, o el que hay ya venció
+    bool isStale() const {
+        return !hasVerse || millis() - lastUpdate >= VERSE_UPDATE_INTERVAL;
+    }
+
+    // Tras un intento fallido se espera VERSE_RETRY_INTERVAL
+    bool attemptDue() const {
+        return !attempted || millis() - lastAttempt >= VERSE_RETRY_INTERVAL;
+    }
+
+    bool fetch() {
+        WiFiClientSecure client;
+        bool fetched = false;
+
+        client.setInsecure();
+
+        // HTTP/1.0 evita la codificación por bloques y permite leer el JSON del stream
+        if (client.connect("labs.bible.org", 443)) {
+            client.print("GET /api/?passage=votd&type=json HTTP/1.0\r\n"
+                         "Host: labs.bible.org\r\n"
+                         "User-Agent: Mozilla/5.0\r\n"
+                         "Accept: application/json\r\n"
+                         "Connection: close\r\n\r\n");
+
+            StaticJsonDocument<1024> doc;
+            if (skipHeaders(client) && !deserializeJson(doc, client)) {
+                const char* bookName = doc[0]["bookname"] | "";
+                unsigned int chapter = doc[0]["chapter"].as<unsigned int>();
+                unsigned int verse = doc[0]["verse"].as<unsigned int>();
+                const char* text = doc[0]["text"] | "";
+
+                fetchedBook = getBookNumber(bookName);
+                fetchedChapter = chapter;
+                fetchedVerseNumber = verse;
+
+                translateText(bookName, translatedBook);
+                translateText(text, fetchedVerse);
+
+                // Guardar la referencia separada
+                fetchedReference.clear();
+                fetchedReference.appendf("%s %u:%u", translatedBook.c_str(), chapter, verse);
+                fetched = true;
+            }
+        }
+
+        client.stop();
+        return fetched;
+    }
+
+    // Traduce al español; si falla deja el texto original
+    template <size_t N>
+    void translateText(const char* text, FixedString<N>& translated) {
+        WiFiClient client;
+        translated = text;
+
+        if (client.connect("clients5.google.com", 80)) {
+            translateRequest.clear();
+            translateRequest.append("GET /translate_a/t?client=dict-chrome-ex&sl=en&tl=es&q=")
+                            .appendUrlEncoded(text)
+                            .append(" HTTP/1.0\r\n");
+
+            client.print(translateRequest.c_str());
+            client.print("Host: clients5.google.com\r\n"
+                         "User-Agent: Mozilla/5.0\r\n"
+                         "Connection: close\r\n\r\n");
+
+            StaticJsonDocument<1024> doc;
+            if (skipHeaders(client) && !deserializeJson(doc, client)) {
+                const char* result = doc[0];
+                if (result != nullptr) {
+                    translated = result;
+                }
+            }
+        }
+
+        client.stop();
+    }
+
+    // Reemplazar la copia publicada de una vez. El render recibe el pasaje
+    // en una sola escritura y el texto por el mutex del overlay, que lo
+    // copia antes de regresar; nada se publica hasta tener la descarga
+    // completa
+    void publish() {
+        xSemaphoreTake(lock, portMAX_DELAY);
+        publishedVerse = fetchedVerse;
+        publishedReference = fetchedReference;
+        xSemaphoreGive(lock);
+
+        ledManager->setPassage(fetchedBook, fetchedChapter, fetchedVerseNumber);
+        ledManager->getOverlay().setScrollText(fetchedVerse.c_str());
+        lastUpdate = millis();
+        hasVerse = true;
+    }
+
+    // Duerme hasta que alguien pida el versículo; si hace falta (y no se
+    // acaba de intentar) lo descarga. Si falla se conserva lo publicado.
+    void run() {
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            if (!isStale() || !attemptDue()) continue;
+
+            lastAttempt = millis();
+            attempted = true;
+            if (fetch()) {
+                publish();
+            }
+        }
+    }
+
+    static void taskEntry(void* param) {
+        static_cast<DailyVerse*>(param)->run();
+    }
+
+public:
+    DailyVerse(LedManager* ledMgr)
+        : ledManager(ledMgr),
+          taskHandle(nullptr),
+          lock(nullptr),
+          fetchedBook(0),
+          fetchedChapter(0),
+          fetchedVerseNumber(0),
+          lastUpdate(0),
+          lastAttempt(0),
+          hasVerse(false),
+          attempted(false) {}
+
+    void begin() {
+        lock = xSemaphoreCreateMutex();
+        xTaskCreatePinnedToCore(taskEntry, "verse", VERSE_TASK_STACK, this, VERSE_TASK_PRIORITY,
+                                &taskHandle, VERSE_TASK_CORE);
+    }
+
+    // Pedir una actualización si la copia venció; nunca espera
+    void request() {
+        if (taskHandle != nullptr && isStale() && attemptDue()) {
+            xTaskNotifyGive(taskHandle);
+        }
+    }
+
+    // Copiar lo publicado; false si todavía no hay versículo
+    bool read(FixedString<VERSE_TEXT_CAPACITY>& text, FixedString<VERSE_REFERENCE_CAPACITY>& reference) {
+        if (lock == nullptr || !hasVerse) return false;
+        xSemaphoreTake(lock, portMAX_DELAY);
+        text = publishedVerse;
+        reference = publishedReference;
+        xSemaphoreGive(lock);
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef EFFECT_ARENA_H
+#define EFFECT_ARENA_H
+
+#include <new>
+#include "config.h"
+#include "effects.h"
+
+// Tamaño de la arena: el efecto más grande decide
+template <typename T>
+constexpr size_t largestEffect() {
+    return sizeof(T);
+}
+
+template <typename T, typename U, typename... Rest>
+constexpr size_t largestEffect() {
+    return sizeof(T) > largestEffect<U, Rest...>() ? sizeof(T) : largestEffect<U, Rest...>();
+}
+
+constexpr size_t EFFECT_ARENA_SIZE =
+    largestEffect<SolidEffect, BreathingEffect, RainbowEffect, FireEffect, LifeEffect, ClockEffect>();
+
+static_assert(EFFECT_ARENA_SIZE <= EFFECT_ARENA_BUDGET,
+              "Un efecto excede EFFECT_ARENA_BUDGET; reducir su estado o subir el presupuesto");
+
+// Memoria de trabajo de cada efecto (OFF no usa arena)
+struct EffectFootprint {
+    LedEffect effect;
+    const char* name;
+    uint16_t bytes;
+};
+
+constexpr EffectFootprint EFFECT_FOOTPRINTS[] = {
+    {SOLID, "solid", sizeof(SolidEffect)},
+    {BREATHING, "breathing", sizeof(BreathingEffect)},
+    {RAINBOW, "rainbow", sizeof(RainbowEffect)},
+    {FIRE, "fire", sizeof(FireEffect)},
+    {LIFE, "life", sizeof(LifeEffect)},
+    {CLOCK, "clock", sizeof(ClockEffect)},
+    {OFF, "off", 0}
+};
+
+constexpr uint8_t EFFECT_FOOTPRINT_COUNT = sizeof(EFFECT_FOOTPRINTS) / sizeof(EFFECT_FOOTPRINTS[0]);
+
+inline const char* effectName(LedEffect effect) {
+    for (uint8_t i = 0; i < EFFECT_FOOTPRINT_COUNT; i++) {
+        if (EFFECT_FOOTPRINTS[i].effect == effect) return EFFECT_FOOTPRINTS[i].name;
+    }
+    return "unknown";
+}
+
+// Bloque fijo donde vive el estado del efecto activo. Cambiar de efecto
+// destruye el anterior y construye el nuevo en el mismo espacio, así que
+// solo el efecto en uso ocupa DRAM y siempre arranca desde cero.
+class EffectArena {
+private:
+    alignas(8) uint8_t storage[EFFECT_ARENA_SIZE];
+    Effect* active;
+    uint16_t activeBytes;
+
+public:
+    EffectArena() : active(nullptr), activeBytes(0) {}
+
+    ~EffectArena() {
+        clear();
+    }
+
+    template <typename T>
+    T* emplace() {
+        static_assert(sizeof(T) <= EFFECT_ARENA_SIZE, "El efecto no cabe en la arena");
+        static_assert(alignof(T) <= 8, "Alineación del efecto no soportada");
+        clear();
+        T* effect = new (storage) T();
+        active = effect;
+        activeBytes = sizeof(T);
+        return effect;
+    }
+
+    void clear() {
+        if (active != nullptr) {
+            active->~Effect();
+            active = nullptr;
+            activeBytes = 0;
+        }
+    }
+
+    Effect* get() const {
+        return active;
+    }
+
+    uint16_t getActiveBytes() const {
+        return activeBytes;
+    }
+
+    static void printReport() {
+        Serial.printf("Arena de efectos: %u bytes (presupuesto %u)\n",
+                      (unsigned)EFFECT_ARENA_SIZE, (unsigned)EFFECT_ARENA_BUDGET);
+        for (uint8_t i = 0; i < EFFECT_FOOTPRINT_COUNT; i++) {
+            Serial.printf("  %-10s %5u bytes\n", EFFECT_FOOTPRINTS[i].name, EFFECT_FOOTPRINTS[i].bytes);
+        }
+    }
+};
+
+// Construir un efecto en la arena (nullptr y arena vacía para OFF)
+inline Effect* emplaceEffect(EffectArena& arena, LedEffect effect) {
+    switch (effect) {
+        case SOLID: return arena.emplace<SolidEffect>();
+        case BREATHING: return arena.emplace<BreathingEffect>();
+        case RAINBOW: return arena.emplace<RainbowEffect>();
+        case FIRE: return arena.emplace<FireEffect>();
+        case LIFE: return arena.emplace<LifeEffect>();
+        case CLOCK: return arena.emplace<ClockEffect>();
+        case OFF:
+        default:
+            arena.clear();
+            return nullptr;
+    }
+}
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef EFFECT_LAYERS_H
+#define EFFECT_LAYERS_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "config.h"
+#include "matrix_geometry.h"
+#include "pixel_ops.h"
+#include "symmetry.h"
+#include "post_fx.h"
+
+// Capas que se componen sobre el efecto base. Cada capa es un generador (un
+// efecto cualquiera con su propia arena y ranura del planificador) más sus
+// modificadores, todos propios de la capa. Los espaciales (simetría y
+// desenfoque) se aplican al dibujar el generador en el frame de la capa; los
+// de pixel (giro de tono, máscara, opacidad y modo de mezcla) se funden en
+// una sola pasada sobre leds[], así que apilar modificadores no agrega
+// recorridos del frame. El efecto base conserva su simetría y desenfoque
+// por efecto (/api/symmetry y /api/postfx).
+enum BlendMode : uint8_t {
+    BLEND_NORMAL,    // La capa tapa al fondo según su opacidad
+    BLEND_ADD,       // Suma con saturación (el negro de la capa no tapa)
+    BLEND_MULTIPLY,
+    BLEND_SCREEN,
+    BLEND_LIGHTEN,   // El mayor de cada canal
+    BLEND_MODE_COUNT
+};
+
+// Máscaras por fila: la opacidad de la capa varía con la altura
+enum LayerMask : uint8_t {
+    MASK_NONE,
+    MASK_BOTTOM,  // Visible abajo, se desvanece hacia arriba
+    MASK_TOP,     // Visible arriba, se desvanece hacia abajo
+    MASK_BAND,    // Visible en el centro, se desvanece hacia ambos bordes
+    LAYER_MASK_COUNT
+};
+
+struct LayerConfig {
+    LedEffect effect;   // OFF = capa apagada
+    BlendMode blend;
+    uint8_t opacity;
+    uint8_t hueShift;   // Giro de tono, 0-255 = una vuelta
+    LayerMask mask;
+    SymmetryMode symmetry;  // Solo si el generador dibuja por región
+    PostFxSettings postFx;
+};
+
+class LayerCompositor {
+public:
+    static constexpr const char* BLEND_NAMES[BLEND_MODE_COUNT] = {"normal", "add", "multiply", "screen", "lighten"};
+    static constexpr const char* MASK_NAMES[LAYER_MASK_COUNT] = {"none", "bottom", "top", "band"};
+
+private:
+    // Giro de tono como rotación alrededor del eje gris: una matriz 3x3
+    // circulante de la que bastan tres coeficientes (8.8)
+    int16_t rotation[3];
+    int16_t rotationShift;  // Giro con el que se calculó rotation (-1 = ninguno)
+
+    void buildRotation(uint8_t shift) {
+        const float angle = shift * (6.2831853f / 256.0f);  // Una vuelta cada 256
+        const float c = cosf(angle);
+        const float s = sinf(angle) * 0.57735f;  // sin / sqrt(3)
+        const float k = (1.0f - c) / 3.0f;
+        rotation[0] = lroundf((c + k) * 256);
+        rotation[1] = lroundf((k - s) * 256);
+        rotation[2] = lroundf((k + s) * 256);
+        rotationShift = shift;
+    }
+
+    static uint8_t clampChannel(int32_t value) {
+        return value < 0 ? 0 : (value > 255 ? 255 : value);
+    }
+
+    CRGB rotate(const CRGB& color) const {
+        return CRGB(clampChannel((rotation[0] * color.r + rotation[1] * color.g + rotation[2] * color.b) >> 8),
+                    clampChannel((rotation[2] * color.r + rotation[0] * color.g + rotation[1] * color.b) >> 8),
+                    clampChannel((rotation[1] * color.r + rotation[2] * color.g + rotation[0] * color.b) >> 8));
+    }
+
+    static uint8_t maskAlpha(LayerMask mask, uint8_t y) {
+        const uint8_t level = Matrix::HEIGHT_LEVEL[y];
+        switch (mask) {
+            case MASK_BOTTOM: return 255 - level;
+            case MASK_TOP: return level;
+            case MASK_BAND: return 255 - abs(2 * level - 255);
+            default: return 255;
+        }
+    }
+
+    // Color que la capa deja donde es completamente opaca
+    template <BlendMode MODE>
+    static CRGB blendTarget(const CRGB& base, const CRGB& layer) {
+        switch (MODE) {
+            case BLEND_ADD: return base + layer;
+            case BLEND_MULTIPLY:
+                return CRGB(scale8(base.r, layer.r), scale8(base.g, layer.g), scale8(base.b, layer.b));
+            case BLEND_SCREEN:
+                return CRGB(255 - scale8(255 - base.r, 255 - layer.r),
+                            255 - scale8(255 - base.g, 255 - layer.g),
+                            255 - scale8(255 - base.b, 255 - layer.b));
+            case BLEND_LIGHTEN:
+                return CRGB(max(base.r, layer.r), max(base.g, layer.g), max(base.b, layer.b));
+            default: return layer;
+        }
+    }
+
+    // La pasada fusionada: giro de tono, máscara, opacidad y mezcla en un
+    // solo recorrido. El modo va como parámetro de plantilla para que el
+    // bucle interno no tenga que elegirlo en cada pixel.
+    template <BlendMode MODE>
+    void compositeWith(CRGB* leds, const CRGB* layer, const LayerConfig& config) const {
+        const bool rotating = config.hueShift != 0;
+        for (uint8_t y = 0; y < Matrix::HEIGHT; y++) {
+            const uint8_t alpha = scale8(config.opacity, maskAlpha(config.mask, y));
+            if (alpha == 0) continue;
+            const uint16_t t = alpha + (alpha >> 7);  // 255 -> 256
+
+            for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+                const uint16_t i = Matrix::xy(x, y);
+                const CRGB color = rotating ? rotate(layer[i]) : layer[i];
+                const CRGB target = blendTarget<MODE>(leds[i], color);
+                leds[i] = t == 256 ? target
+                    : PixelOps::unpack(PixelOps::lerp8x4(PixelOps::pack(leds[i]), PixelOps::pack(target), t));
+            }
+        }
+    }
+
+public:
+    LayerCompositor() : rotationShift(-1) {}
+
+    static const char* blendName(BlendMode mode) {
+        return mode < BLEND_MODE_COUNT ? BLEND_NAMES[mode] : BLEND_NAMES[BLEND_NORMAL];
+    }
+
+    static const char* maskName(LayerMask mask) {
+        return mask < LAYER_MASK_COUNT ? MASK_NAMES[mask] : MASK_NAMES[MASK_NONE];
+    }
+
+    // BLEND_MODE_COUNT / LAYER_MASK_COUNT si el nombre no existe
+    static BlendMode blendFromName(const char* value) {
+        for (uint8_t i = 0; i < BLEND_MODE_COUNT; i++) {
+            if (strcmp(value, BLEND_NAMES[i]) == 0) return static_cast<BlendMode>(i);
+        }
+        return BLEND_MODE_COUNT;
+    }
+
+    static LayerMask maskFromName(const char* value) {
+        for (uint8_t i = 0; i < LAYER_MASK_COUNT; i++) {
+            if (strcmp(value, MASK_NAMES[i]) == 0) return static_cast<LayerMask>(i);
+        }
+        return LAYER_MASK_COUNT;
+    }
+
+    // Mezclar la capa ya dibujada sobre leds[]
+    void composite(CRGB* leds, const CRGB* layer, const LayerConfig& config) {
+        if (config.opacity == 0) return;
+        if (config.hueShift != 0 && config.hueShift != rotationShift) {
+            buildRotation(config.hueShift);
+        }
+
+        switch (config.blend) {
+            case BLEND_ADD: compositeWith<BLEND_ADD>(leds, layer, config); break;
+            case BLEND_MULTIPLY: compositeWith<BLEND_MULTIPLY>(leds, layer, config); break;
+            case BLEND_SCREEN: compositeWith<BLEND_SCREEN>(leds, layer, config); break;
+            case BLEND_LIGHTEN: compositeWith<BLEND_LIGHTEN>(leds, layer, config); break;
+            default: compositeWith<BLEND_NORMAL>(leds, layer, config); break;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,852 @@
+#ifndef EFFECTS_H
+#define EFFECTS_H
+
+#include <FastLED.h>
+#include <NTPClient.h>
+#include <WiFiUdp.h>
+#include "config.h"
+#include "matrix_geometry.h"
+#include "fixed_string.h"
+#include "pixel_ops.h"
+
+// Variantes del arcoíris (el orden coincide con LedManager::RAINBOW_TYPES)
+enum RainbowType {
+    RAINBOW_DIAGONAL,
+    RAINBOW_HORIZONTAL,
+    RAINBOW_VERTICAL,
+    RAINBOW_CIRCULAR,
+    RAINBOW_TYPE_COUNT
+};
+
+// Parámetros que el LedManager pasa a los efectos en cada frame
+struct EffectParams {
+    uint8_t hue;
+    uint8_t saturation;
+    uint8_t firePalette;
+    RainbowType rainbowType;
+    uint8_t lifePattern;
+    float lifeSpeed;
+    bool autoRestart;
+    uint8_t book;
+    uint8_t chapter;
+    uint8_t verse;
+    uint16_t stepBlend;  // Avance hacia el siguiente paso, 0-256 (ver render())
+    QualityTier quality;
+    uint8_t regionWidth;   // Región a calcular con simetría (ver symmetry.h)
+    uint8_t regionHeight;
+};
+
+// Base de los efectos. Todo el estado de trabajo de un efecto vive en el
+// propio objeto, que se construye dentro de la arena (ver effect_arena.h)
+// solo mientras el efecto está activo.
+//
+// Los efectos no miden el tiempo: declaran cada cuánto avanza su
+// simulación y el FrameScheduler llama a step() las veces que toque antes
+// de render(), que solo dibuja. Un efecto con pasos más lentos que la
+// pantalla puede guardar el estado anterior y mezclarlo con el actual
+// según params.stepBlend (0 = estado anterior, 256 = estado actual).
+class Effect {
+public:
+    virtual ~Effect() {}
+
+    // Se llama una vez al entrar al efecto
+    virtual void begin(const EffectParams& params) {}
+
+    // Microsegundos entre pasos de simulación (0 = estático o en pausa)
+    virtual uint32_t stepInterval(const EffectParams& params) const {
+        return 0;
+    }
+
+    virtual void step(const EffectParams& params) {}
+
+    virtual void render(CRGB* leds, const EffectParams& params) = 0;
+
+    // Niveles que el efecto implementa; params.quality nunca pasa de aquí
+    virtual uint8_t qualityTiers() const {
+        return 1;
+    }
+
+    // true si el efecto respeta params.regionWidth/regionHeight; los demás
+    // siempre se dibujan completos y sin simetría
+    virtual bool supportsSymmetry() const {
+        return false;
+    }
+};
+
+class SolidEffect : public Effect {
+public:
+    void render(CRGB* leds, const EffectParams& params) override {
+        fill_solid(leds, NUM_LEDS, CHSV(params.hue, params.saturation, 255));
+    }
+};
+
+class BreathingEffect : public Effect {
+private:
+    uint8_t breathVal = 0;
+    bool breathingUp = true;
+
+public:
+    static const uint32_t STEP_INTERVAL_US = 20000;
+
+    uint32_t stepInterval(const EffectParams& params) const override {
+        return STEP_INTERVAL_US;
+    }
+
+    void step(const EffectParams& params) override {
+        if (breathingUp) {
+            breathVal += 2;
+            if (breathVal >= 252) breathingUp = false;
+        } else {
+            breathVal -= 2;
+            if (breathVal <= 0) breathingUp = true;
+        }
+    }
+
+    void render(CRGB* leds, const EffectParams& params) override {
+        fill_solid(leds, NUM_LEDS, CHSV(params.hue, params.saturation, breathVal));
+    }
+};
+
+class RainbowEffect : public Effect {
+private:
+    uint8_t phase = 0;  // Desplazamiento animado sobre el tono base
+
+    // Pintar un bloque de block x block pixeles (1 = un pixel)
+    static void fillBlock(CRGB* leds, uint8_t x, uint8_t y, uint8_t block, const CRGB& color) {
+        for(uint8_t dy = 0; dy < block && y + dy < Matrix::HEIGHT; dy++) {
+            for(uint8_t dx = 0; dx < block && x + dx < Matrix::WIDTH; dx++) {
+                leds[Matrix::xy(x + dx, y + dy)] = color;
+            }
+        }
+    }
+
+    void updateDiagonal(CRGB* leds, uint8_t hue, uint8_t saturation, uint8_t block,
+                        uint8_t width, uint8_t height) {
+        for(uint8_t x = 0; x < width; x += block) {
+            uint8_t columnHue = hue + Matrix::ANGLE[x];
+
+            for(uint8_t y = 0; y < height; y += block) {
+                uint8_t finalHue = columnHue + (y * 255 / Matrix::HEIGHT / 2);
+                fillBlock(leds, x, y, block, CHSV(finalHue, saturation, 255));
+            }
+        }
+    }
+
+    void updateHorizontal(CRGB* leds, uint8_t hue, uint8_t saturation, uint8_t width, uint8_t height) {
+        for(uint8_t y = 0; y < height; y++) {
+            uint8_t rowHue = hue + (y * 255 / Matrix::HEIGHT);
+            for(uint8_t x = 0; x < width; x++) {
+                leds[Matrix::xy(x, y)] = CHSV(rowHue, saturation, 255);
+            }
+        }
+    }
+
+    void updateVertical(CRGB* leds, uint8_t hue, uint8_t saturation, uint8_t width, uint8_t height) {
+        for(uint8_t x = 0; x < width; x++) {
+            uint8_t columnHue = hue + Matrix::ANGLE[x];
+            for(uint8_t y = 0; y < height; y++) {
+                leds[Matrix::xy(x, y)] = CHSV(columnHue, saturation, 255);
+            }
+        }
+    }
+
+    void updateCircular(CRGB* leds, uint8_t hue, uint8_t saturation, uint8_t block,
+                        uint8_t width, uint8_t height) {
+        uint8_t centerX = Matrix::WIDTH / 2;
+        uint8_t centerY = Matrix::HEIGHT / 2;
+
+        for(uint8_t x = 0; x < width; x += block) {
+            for(uint8_t y = 0; y < height; y += block) {
+                float distance = sqrt(pow(x - centerX, 2) + pow(y - centerY, 2));
+                uint8_t finalHue = hue + (distance * 255 / max(Matrix::WIDTH, Matrix::HEIGHT));
+                fillBlock(leds, x, y, block, CHSV(finalHue, saturation, 255));
+            }
+        }
+    }
+
+public:
+    static const uint32_t STEP_INTERVAL_US = 20000;
+
+    uint32_t stepInterval(const EffectParams& params) const override {
+        return STEP_INTERVAL_US;
+    }
+
+    void step(const EffectParams& params) override {
+        phase++;
+    }
+
+    // Calidad reducida: diagonal y circular calculan un color por bloque de 2x2
+    uint8_t qualityTiers() const override {
+        return 2;
+    }
+
+    bool supportsSymmetry() const override {
+        return true;
+    }
+
+    void render(CRGB* leds, const EffectParams& params) override {
+        const uint8_t hue = params.hue + phase;
+        const uint8_t block = params.quality == QUALITY_FULL ? 1 : 2;
+        const uint8_t width = params.regionWidth;
+        const uint8_t height = params.regionHeight;
+        switch (params.rainbowType) {
+            case RAINBOW_HORIZONTAL: updateHorizontal(leds, hue, params.saturation, width, height); break;
+            case RAINBOW_VERTICAL: updateVertical(leds, hue, params.saturation, width, height); break;
+            case RAINBOW_CIRCULAR: updateCircular(leds, hue, params.saturation, block, width, height); break;
+            default: updateDiagonal(leds, hue, params.saturation, block, width, height); break;
+        }
+    }
+};
+
+class FireEffect : public Effect {
+public:
+    static const uint8_t PALETTE_COUNT = 6;
+    static const uint8_t PALETTE_SIZE = 6;
+    static const uint32_t STEP_INTERVAL_US = 40000;  // El fuego avanza a 25 Hz
+
+private:
+    // Paletas en flash como bytes RGB crudos
+    static constexpr uint8_t PALETTES[PALETTE_COUNT][PALETTE_SIZE][3] = {
+        { // Rojo
+            {0, 0, 0},            // negro
+            {128, 0, 0},          // rojo oscuro
+            {179, 0, 0},          // rojo medio
+            {255, 0, 0},          // rojo
+            {255, 64, 0},         // rojo-naranja
+            {255, 128, 0}         // naranja
+        },
+        { // Rojo claro/Naranja
+            {0, 0, 0},            // negro
+            {255, 0, 0},          // rojo
+            {255, 64, 0},         // rojo-naranja
+            {255, 128, 0},        // naranja
+            {255, 192, 64},       // naranja claro
+            {255, 255, 128}       // amarillo claro
+        },
+        { // Amarillo
+            {0, 0, 0},            // negro
+            {128, 64, 0},         // ámbar oscuro
+            {192, 128, 0},        // ámbar
+            {255, 192, 0},        // amarillo oscuro
+            {255, 255, 0},        // amarillo
+            {255, 255, 128}       // amarillo claro
+        },
+        { // Verde
+            {0, 0, 0},            // negro
+            {0, 32, 0},           // verde muy oscuro
+            {0, 64, 0},           // verde oscuro
+            {0, 128, 0},          // verde medio
+            {32, 192, 0},         // verde claro
+            {64, 255, 0}          // verde brillante
+        },
+        { // Azul
+            {0, 0, 0},            // negro
+            {0, 0, 128},          // azul oscuro
+            {0, 0, 192},          // azul medio
+            {0, 0, 255},          // azul
+            {0, 128, 255},        // azul claro
+            {128, 192, 255}       // azul muy claro
+        },
+        { // Negro
+            {0, 0, 0},            // negro
+            {16, 16, 16},         // gris muy oscuro
+            {32, 32, 32},         // gris oscuro
+            {64, 64, 64},         // gris medio
+            {96, 96, 96},         // gris claro
+            {128, 128, 128}       // gris
+        }
+    };
+
+protected:
+    // Calor de cada pixel: nibble bajo = paso actual, nibble alto = anterior.
+    // Fuera de la región de simetría queda sin tocar: render() no lo lee
+    uint8_t firePixels[NUM_LEDS];
+
+    static uint8_t heat(uint8_t pixel) {
+        return pixel & 0x0F;
+    }
+
+public:
+    void begin(const EffectParams& params) override {
+        memset(firePixels, 0, sizeof(firePixels));
+
+        // La fila de la base nunca cambia; ambos nibbles llevan el mismo calor
+        // En anillo no hay extremos: toda la base arde por igual
+        if (Matrix::RING) {
+            for(uint8_t x = 0; x < Matrix::WIDTH; x++) {
+                firePixels[Matrix::xy(x, 0)] = (PALETTE_SIZE - 1) * 0x11;
+            }
+            return;
+        }
+
+        const uint8_t centerStart = (uint8_t)(Matrix::WIDTH * 0.15);
+        const uint8_t centerEnd = (uint8_t)(Matrix::WIDTH * 0.85);
+
+        for(uint8_t x = 0; x < Matrix::WIDTH; x++) {
+            if (x >= centerStart && x <= centerEnd) {
+                firePixels[Matrix::xy(x, 0)] = (PALETTE_SIZE - 1) * 0x11;
+            } else {
+                uint8_t distanceFromCenter = min((int)abs(x - centerStart), (int)abs(x - centerEnd));
+                uint8_t intensity = (4 - distanceFromCenter) > 0 ? (4 - distanceFromCenter) : 0;
+                firePixels[Matrix::xy(x, 0)] = intensity * 0x11;
+            }
+        }
+    }
+
+    uint32_t stepInterval(const EffectParams& params) const override {
+        return STEP_INTERVAL_US;
+    }
+
+    // Calidad reducida: se simula media resolución horizontal y cada
+    // columna calculada se copia a su vecina
+    uint8_t qualityTiers() const override {
+        return 2;
+    }
+
+    bool supportsSymmetry() const override {
+        return true;
+    }
+
+    void step(const EffectParams& params) override {
+        // El calor actual pasa a ser el anterior, solo en la región
+        for(uint8_t y = 0; y < params.regionHeight; y++) {
+            for(uint8_t x = 0; x < params.regionWidth; x++) {
+                const uint16_t i = Matrix::xy(x, y);
+                firePixels[i] = heat(firePixels[i]) * 0x11;
+            }
+        }
+
+        const uint8_t columnStep = params.quality == QUALITY_FULL ? 1 : 2;
+        for(uint8_t x = 0; x < params.regionWidth; x += columnStep) {
+            for(uint8_t y = 1; y < params.regionHeight; y++) {
+                const uint8_t decay = random(2.1);
+                int8_t drift = random(3) - 1;
+
+                // En un panel plano las llamas se alejan de los bordes; en
+                // anillo la deriva cruza de la última columna a la primera
+                if (!Matrix::RING) {
+                    if (x < Matrix::WIDTH * 0.2) {
+                        drift = drift < 0 ? 0 : drift;
+                    } else if (x > Matrix::WIDTH * 0.8) {
+                        drift = drift > 0 ? 0 : drift;
+                    }
+                }
+
+                // Con simetría horizontal la región termina en el eje del
+                // espejo: la deriva no lo cruza ni da la vuelta del anillo,
+                // porque ese calor caería fuera de la región y se perdería
+                if (params.regionWidth < Matrix::WIDTH) {
+                    if (x == 0 && drift < 0) drift = 0;
+                    if (x + 1 >= params.regionWidth && drift > 0) drift = 0;
+                }
+
+                const uint8_t newX = Matrix::shiftX(x, drift);
+
+                uint16_t belowIndex = Matrix::xy(x, y-1);
+                uint16_t targetIndex = Matrix::xy(newX, y);
+
+                int16_t value = heat(firePixels[belowIndex]);
+                if(value > decay) {
+                    value -= decay;
+                } else {
+                    value = 0;
+                }
+
+                if (random(10) == 0 && value > 0) {
+                    value += random(3);
+                    if(value >= PALETTE_SIZE) value = PALETTE_SIZE - 1;
+                }
+
+                firePixels[targetIndex] = (firePixels[targetIndex] & 0xF0) | value;
+                const uint8_t pairX = Matrix::rightOf(newX);
+                if (columnStep > 1 && pairX != newX && pairX < params.regionWidth) {
+                    const uint16_t pairIndex = Matrix::xy(pairX, y);
+                    firePixels[pairIndex] = (firePixels[pairIndex] & 0xF0) | value;
+                }
+            }
+        }
+    }
+
+    // Solo hay PALETTE_SIZE^2 transiciones posibles: se mezclan una vez por
+    // frame y cada pixel solo busca la suya
+    void render(CRGB* leds, const EffectParams& params) override {
+        const uint8_t (*palette)[3] = PALETTES[params.firePalette < PALETTE_COUNT ? params.firePalette : 0];
+
+        uint32_t packed[PALETTE_SIZE];
+        for(uint8_t i = 0; i < PALETTE_SIZE; i++) {
+            packed[i] = PixelOps::pack(palette[i][0], palette[i][1], palette[i][2]);
+        }
+
+        CRGB blended[PALETTE_SIZE << 4];
+        for(uint8_t from = 0; from < PALETTE_SIZE; from++) {
+            for(uint8_t to = 0; to < PALETTE_SIZE; to++) {
+                blended[(from << 4) | to] = PixelOps::unpack(
+                    PixelOps::lerp8x4(packed[from], packed[to], params.stepBlend));
+            }
+        }
+
+        for(uint8_t y = 0; y < params.regionHeight; y++) {
+            for(uint8_t x = 0; x < params.regionWidth; x++) {
+                const uint16_t i = Matrix::xy(x, y);
+                leds[i] = blended[firePixels[i]];
+            }
+        }
+    }
+};
+
+// Juego de la Vida. Cada fila es una máscara de bits (bit x = columna x),
+// así las dos generaciones ocupan 208 bytes en lugar de 1404. Se conserva
+// la generación anterior para que las células aparezcan y se apaguen con
+// un fundido entre pasos.
+class LifeEffect : public Effect {
+public:
+    enum Pattern {
+        RANDOM,
+        BLOCK,
+        BLINKER,
+        GLIDER,
+        TOAD,
+        BEACON,
+        LWSS
+    };
+
+private:
+    static const uint32_t BASE_STEP_INTERVAL_US = 100000;  // Una generación a velocidad 1x
+
+    uint32_t lifeGrid[Matrix::HEIGHT];
+    uint32_t prevGrid[Matrix::HEIGHT];   // Generación anterior (y área de cálculo)
+
+    bool cell(uint8_t x, uint8_t y) const {
+        return (lifeGrid[y] >> x) & 1;
+    }
+
+    void setCell(uint8_t x, uint8_t y) {
+        lifeGrid[y] |= (uint32_t)1 << x;
+    }
+
+    void initLife() {
+        // Inicializar con patrón aleatorio
+        for(uint8_t y = 0; y < Matrix::HEIGHT; y++) {
+            lifeGrid[y] = 0;
+            for(uint8_t x = 0; x < Matrix::WIDTH; x++) {
+                if (random(2) == 1) setCell(x, y);
+            }
+        }
+    }
+
+    uint8_t countNeighbors(uint8_t x, uint8_t y) const {
+        uint8_t count = 0;
+        for(int8_t i = -1; i <= 1; i++) {
+            for(int8_t j = -1; j <= 1; j++) {
+                if(i == 0 && j == 0) continue;
+
+                int8_t newX = x + i;
+                int8_t newY = y + j;
+
+                // Manejo de bordes toroidales
+                if(newX < 0) newX = Matrix::WIDTH - 1;
+                if(newX >= Matrix::WIDTH) newX = 0;
+                if(newY < 0) newY = Matrix::HEIGHT - 1;
+                if(newY >= Matrix::HEIGHT) newY = 0;
+
+                if(cell(newX, newY)) count++;
+            }
+        }
+        return count;
+    }
+
+    void nextGeneration(bool autoRestart) {
+        // Calcular siguiente generación sobre la anterior, que ya no se usa
+        for(uint8_t y = 0; y < Matrix::HEIGHT; y++) {
+            prevGrid[y] = 0;
+            for(uint8_t x = 0; x < Matrix::WIDTH; x++) {
+                uint8_t neighbors = countNeighbors(x, y);
+                bool alive = neighbors == 3 || (neighbors == 2 && cell(x, y));
+                if (alive) prevGrid[y] |= (uint32_t)1 << x;
+            }
+        }
+
+        bool hasChange = false;
+        for(uint8_t y = 0; y < Matrix::HEIGHT; y++) {
+            const uint32_t next = prevGrid[y];
+            if(lifeGrid[y] != next) hasChange = true;
+            prevGrid[y] = lifeGrid[y];
+            lifeGrid[y] = next;
+        }
+
+        // Reiniciar cuando la población se estanca
+        if(!hasChange && autoRestart) {
+            initLife();
+        }
+    }
+
+public:
+    void setPattern(uint8_t pattern) {
+        for(uint8_t y = 0; y < Matrix::HEIGHT; y++) {
+            lifeGrid[y] = 0;
+        }
+
+        // Posición aleatoria para el patrón
+        uint8_t startX = random(5, Matrix::WIDTH - 5);
+        uint8_t startY = random(5, Matrix::HEIGHT - 5);
+
+        switch(pattern) {
+            case BLOCK:
+                setCell(startX, startY);
+                setCell(startX+1, startY);
+                setCell(startX, startY+1);
+                setCell(startX+1, startY+1);
+                break;
+
+            case BLINKER:
+                setCell(startX-1, startY);
+                setCell(startX, startY);
+                setCell(startX+1, startY);
+                break;
+
+            case GLIDER:
+                setCell(startX, startY-1);
+                setCell(startX+1, startY);
+                setCell(startX-1, startY+1);
+                setCell(startX, startY+1);
+                setCell(startX+1, startY+1);
+                break;
+
+            case TOAD:
+                setCell(startX-1, startY);
+                setCell(startX, startY);
+                setCell(startX+1, startY);
+                setCell(startX-2, startY+1);
+                setCell(startX-1, startY+1);
+                setCell(startX, startY+1);
+                break;
+
+            case BEACON:
+                setCell(startX, startY);
+                setCell(startX+1, startY);
+                setCell(startX, startY+1);
+                setCell(startX+1, startY+1);
+                setCell(startX+2, startY+2);
+                setCell(startX+3, startY+2);
+                setCell(startX+2, startY+3);
+                setCell(startX+3, startY+3);
+                break;
+
+            case LWSS:
+                setCell(startX+1, startY);
+                setCell(startX+4, startY);
+                setCell(startX, startY+1);
+                setCell(startX, startY+2);
+                setCell(startX+4, startY+2);
+                setCell(startX+1, startY+3);
+                setCell(startX+2, startY+3);
+                setCell(startX+3, startY+3);
+                break;
+
+            case RANDOM:
+            default:
+                initLife();
+                break;
+        }
+
+        // Un patrón nuevo aparece sin fundido
+        memcpy(prevGrid, lifeGrid, sizeof(lifeGrid));
+    }
+
+    void begin(const EffectParams& params) override {
+        setPattern(params.lifePattern);
+    }
+
+    uint32_t stepInterval(const EffectParams& params) const override {
+        if (params.lifeSpeed <= 0) return 0;  // 0 = pausa
+        return BASE_STEP_INTERVAL_US / params.lifeSpeed;
+    }
+
+    void step(const EffectParams& params) override {
+        nextGeneration(params.autoRestart);
+    }
+
+    // Calidad reducida: sin fundido entre generaciones
+    uint8_t qualityTiers() const override {
+        return 2;
+    }
+
+    void render(CRGB* leds, const EffectParams& params) override {
+        // Color por transición: bit 1 = viva antes, bit 0 = viva ahora
+        const uint16_t blend = params.quality == QUALITY_FULL ? params.stepBlend : 256;
+        const uint32_t white = PixelOps::pack(CRGB(CRGB::White));
+        CRGB colors[4];
+        for(uint8_t state = 0; state < 4; state++) {
+            colors[state] = PixelOps::unpack(PixelOps::lerp8x4(
+                state & 2 ? white : 0, state & 1 ? white : 0, blend));
+        }
+
+        for(uint8_t y = 0; y < Matrix::HEIGHT; y++) {
+            const uint32_t before = prevGrid[y];
+            const uint32_t now = lifeGrid[y];
+            for(uint8_t x = 0; x < Matrix::WIDTH; x++) {
+                const uint8_t state = (((before >> x) & 1) << 1) | ((now >> x) & 1);
+                leds[Matrix::xy(x, y)] = colors[state];
+            }
+        }
+    }
+};
+
+class ClockEffect : public Effect {
+private:
+    // Patrón único para los dígitos (5x3)
+    static constexpr bool DIGIT_PATTERNS[10][5][3] = {
+        { // 0
+            {1,1,1},
+            {1,0,1},
+            {1,0,1},
+            {1,0,1},
+            {1,1,1}
+        },
+        { // 1
+            {0,1,0},
+            {1,1,0},
+            {0,1,0},
+            {0,1,0},
+            {1,1,1}
+        },
+        { // 2
+            {1,1,1},
+            {0,0,1},
+            {1,1,1},
+            {1,0,0},
+            {1,1,1}
+        },
+        { // 3
+            {1,1,1},
+            {0,0,1},
+            {0,1,1},
+            {0,0,1},
+            {1,1,1}
+        },
+        { // 4
+            {1,0,1},
+            {1,0,1},
+            {1,1,1},
+            {0,0,1},
+            {0,0,1}
+        },
+        { // 5
+            {1,1,1},
+            {1,0,0},
+            {1,1,1},
+            {0,0,1},
+            {1,1,1}
+        },
+        { // 6
+            {1,1,1},
+            {1,0,0},
+            {1,1,1},
+            {1,0,1},
+            {1,1,1}
+        },
+        { // 7
+            {1,1,1},
+            {0,0,1},
+            {0,1,0},
+            {0,1,0},
+            {0,1,0}
+        },
+        { // 8
+            {1,1,1},
+            {1,0,1},
+            {1,1,1},
+            {1,0,1},
+            {1,1,1}
+        },
+        { // 9
+            {1,1,1},
+            {1,0,1},
+            {1,1,1},
+            {0,0,1},
+            {1,1,1}
+        }
+    };
+
+    static constexpr bool MINI_DIGITS[10][3][2] = {
+        { // 0
+            {0,0},
+            {0,0},
+            {1,1}
+        },
+        { // 1
+            {1,0},
+            {1,0},
+            {1,0}
+        },
+        { // 2
+            {1,0},
+            {0,0},
+            {0,1}
+        },
+        { // 3
+            {0,1},
+            {0,0},
+            {1,1}
+        },
+        { // 4
+            {0,1},
+            {1,1},
+            {0,1}
+        },
+        { // 5
+            {1,1},
+            {1,0},
+            {1,1}
+        },
+        { // 6
+            {1,0},
+            {1,1},
+            {1,1}
+        },
+        { // 7
+            {1,1},
+            {0,1},
+            {0,1}
+        },
+        { // 8
+            {1,1},
+            {1,1},
+            {1,1}
+        },
+        { // 9
+            {1,1},
+            {1,1},
+            {0,1}
+        }
+    };
+
+    // El cliente NTP solo existe mientras el reloj está activo
+    WiFiUDP ntpUDP;
+    NTPClient timeClient;
+
+    // Función para dibujar la hora
+    void drawTime(CRGB* leds, const char* time, int x, int y, CRGB color) {
+        int xOffset = x;
+        for (const char* p = time; *p != '\0'; p++) {
+            const char c = *p;
+            if (c >= '0' && c <= '9') {
+                drawDigit(leds, c, xOffset, y, color);
+                xOffset += 4;  // Espacio entre dígitos
+            } else if (c == ':') {
+                drawColon(leds, xOffset, y, color);
+                xOffset += 2;  // Espacio para los dos puntos
+            }
+        }
+    }
+
+    // Función para dibujar dígitos grandes (hora)
+    void drawDigit(CRGB* leds, char digit, int x, int y, CRGB color) {
+        int idx = digit - '0';
+        if (idx < 0 || idx > 9) return;
+
+        for (int dy = 0; dy < 5; dy++) {
+            for (int dx = 0; dx < 3; dx++) {
+                if (DIGIT_PATTERNS[idx][dy][dx]) {
+                    int pixelX = x + dx;
+                    int pixelY = y + dy;
+                    if (pixelX < Matrix::WIDTH && pixelY < Matrix::HEIGHT) {
+                        leds[Matrix::clockXY(pixelX, pixelY)] = color;
+                    }
+                }
+            }
+        }
+    }
+
+    // Función para dibujar dígitos pequeños (pasaje bíblico)
+    void drawMiniDigit(CRGB* leds, char digit, int x, int y, CRGB color) {
+        int idx = digit - '0';
+        if (idx < 0 || idx > 9) return;
+
+        for (int dy = 0; dy < 3; dy++) {
+            for (int dx = 0; dx < 2; dx++) {
+                if (MINI_DIGITS[idx][dy][dx]) {
+                    int pixelX = x + dx;
+                    int pixelY = y + dy;
+                    if (pixelX < Matrix::WIDTH && pixelY < Matrix::HEIGHT) {
+                        leds[Matrix::clockXY(pixelX, pixelY)] = color;
+                    }
+                }
+            }
+        }
+    }
+
+    void drawColon(CRGB* leds, int x, int y, CRGB color) {
+        // Los dígitos son de 5 pixels de alto, así que ponemos los puntos en y+1 y y+3
+        int y1 = y + 1;
+        int y2 = y + 3;
+
+        if (y1 >= 0 && y1 < Matrix::HEIGHT) {
+            leds[Matrix::clockXY(x, y1)] = color;
+        }
+        if (y2 >= 0 && y2 < Matrix::HEIGHT) {
+            leds[Matrix::clockXY(x, y2)] = color;
+        }
+    }
+
+    void drawPassage(CRGB* leds, const char* passage, int x, int y, CRGB color) {
+        int xOffset = x;
+        for (const char* p = passage; *p != '\0'; p++) {
+            const char c = *p;
+            if (c >= '0' && c <= '9') {
+                drawMiniDigit(leds, c, xOffset, y, color);
+                xOffset += 3;  // Espacio entre dígitos
+            } else if (c == ':') {
+                // Dibujar un solo punto para separar, más compacto
+                if (y + 1 < Matrix::HEIGHT) {
+                    leds[Matrix::clockXY(xOffset, y + 1)] = color;
+                }
+                xOffset += 2;  // Menor espacio para el separador
+            }
+        }
+    }
+
+public:
+    ClockEffect() : timeClient(ntpUDP, NTP_SERVER, CLOCK_UTC_OFFSET) {}
+
+    void begin(const EffectParams& params) override {
+        timeClient.begin();
+        timeClient.update();
+    }
+
+    // El NTPClient limita sus consultas; basta revisarlo una vez por segundo
+    uint32_t stepInterval(const EffectParams& params) const override {
+        return 1000000;
+    }
+
+    void step(const EffectParams& params) override {
+        timeClient.update();
+    }
+
+    void render(CRGB* leds, const EffectParams& params) override {
+        fill_solid(leds, NUM_LEDS, CRGB::Black);
+
+        // Obtener y mostrar la hora
+        int hours = timeClient.getHours();
+        int minutes = timeClient.getMinutes();
+
+        if (hours > 12) hours -= 12;
+        if (hours == 0) hours = 12;
+
+        FixedString<8> timeStr;
+        timeStr.appendf("%02d:%02d", hours, minutes);
+
+        // Ancho total = (4 dígitos * 4 espacios) + (2 espacios para los dos puntos) = 18 pixels
+        int totalWidth = (4 * 4) + 2;
+        int startX = (Matrix::WIDTH - totalWidth) / 2;
+
+        drawTime(leds, timeStr.c_str(), startX, 3, CRGB::White);
+
+        // Mostrar el pasaje bíblico en cian
+        FixedString<12> passageStr;
+        passageStr.appendf("%u:%u:%u", params.book, params.chapter, params.verse);
+        drawPassage(leds, passageStr.c_str(), 3, Matrix::HEIGHT - 8, CRGB::Cyan);
+    }
+};
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef FIRMWARE_STREAM_H
+#define FIRMWARE_STREAM_H
+
+#include <Update.h>
+#include <mbedtls/sha256.h>
+#include "config.h"
+
+// Sesión de escritura de una imagen de firmware: cada bloque va directo a
+// la partición OTA inactiva mientras se calcula su SHA-256, sin guardar la
+// imagen completa. La sesión pertenece a quien la abrió (la petición HTTP)
+// y los bloques de cualquier otro se ignoran. La partición de arranque solo
+// cambia si el hash coincide con el esperado.
+class FirmwareStream {
+public:
+    static const uint8_t HASH_SIZE = 32;
+
+private:
+    const void* owner;  // nullptr = sin sesión abierta
+    mbedtls_sha256_context shaContext;
+    uint8_t expectedHash[HASH_SIZE];
+    size_t receivedBytes;
+    const char* error;
+
+    static int8_t hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    void close() {
+        mbedtls_sha256_free(&shaContext);
+        owner = nullptr;
+    }
+
+public:
+    FirmwareStream() : owner(nullptr), receivedBytes(0), error(nullptr) {}
+
+    // 64 dígitos hexadecimales
+    static bool parseHash(const char* hex, uint8_t* hash) {
+        if (strlen(hex) != HASH_SIZE * 2) return false;
+        for (uint8_t i = 0; i < HASH_SIZE; i++) {
+            const int8_t high = hexValue(hex[i * 2]);
+            const int8_t low = hexValue(hex[i * 2 + 1]);
+            if (high < 0 || low < 0) return false;
+            hash[i] = (high << 4) | low;
+        }
+        return true;
+    }
+
+    // false si ya hay una sesión abierta o la partición no se pudo preparar
+    bool begin(const void* requester, const uint8_t* hash) {
+        if (owner != nullptr) {
+            error = "Ya hay una actualización en curso";
+            return false;
+        }
+        // Con multipart el tamaño del archivo no se conoce de antemano
+        if (!Update.begin(UPDATE_SIZE_UNKNOWN, U_FLASH)) {
+            error = Update.errorString();
+            return false;
+        }
+
+        memcpy(expectedHash, hash, HASH_SIZE);
+        mbedtls_sha256_init(&shaContext);
+        mbedtls_sha256_starts(&shaContext, 0);
+        receivedBytes = 0;
+        error = nullptr;
+        owner = requester;
+        return true;
+    }
+
+    bool owns(const void* requester) const {
+        return owner != nullptr && requester == owner;
+    }
+
+    bool isActive() const {
+        return owner != nullptr;
+    }
+
+    // false si el bloque no es del dueño o no se pudo escribir (la sesión
+    // se aborta)
+    bool write(const void* requester, const uint8_t* data, size_t len) {
+        if (!owns(requester)) return false;
+        if (Update.write(const_cast<uint8_t*>(data), len) != len) {
+            abort(Update.errorString());
+            return false;
+        }
+        mbedtls_sha256_update(&shaContext, data, len);
+        receivedBytes += len;
+        return true;
+    }
+
+    // Verificar el hash y, si coincide, cambiar la partición de arranque
+    bool finish(const void* requester) {
+        if (!owns(requester)) return false;
+
+        uint8_t actualHash[HASH_SIZE];
+        mbedtls_sha256_finish(&shaContext, actualHash);
+        close();
+
+        if (memcmp(actualHash, expectedHash, HASH_SIZE) != 0) {
+            Update.abort();
+            error = "SHA-256 no coincide";
+            return false;
+        }
+        if (!Update.end(true)) {
+            error = Update.errorString();
+            return false;
+        }
+        return true;
+    }
+
+    void abort(const char* reason) {
+        if (owner == nullptr) return;
+        Update.abort();
+        close();
+        error = reason;
+    }
+
+    size_t getReceivedBytes() const {
+        return receivedBytes;
+    }
+
+    const char* getError() const {
+        return error;
+    }
+};
+
+#endif
@@ -0,0 +1,237 @@
+#ifndef FIRMWARE_UPDATER_H
+#define FIRMWARE_UPDATER_H
+
+#include <ESPAsyncWebServer.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "firmware_stream.h"
+#include "led_manager.h"
+
+// Actualización de firmware por HTTP en el AsyncWebServer existente.
+// La imagen se escribe por bloques directo en la partición OTA inactiva
+// mientras se calcula su SHA-256; la partición de arranque solo cambia si
+// el hash coincide con el enviado en la cabecera X-Firmware-SHA256.
+// Ver el ejemplo con curl en el README.
+class FirmwareUpdater {
+private:
+    // Resultado de cada petición; vive en request->_tempObject y el
+    // servidor lo libera con free() al destruir la petición
+    struct UploadStatus {
+        const char* error;
+        size_t bytes;
+        unsigned long durationMs;
+        bool succeeded;
+    };
+
+    LedManager* ledManager;
+    FirmwareStream stream;
+
+    // Los bloques llegan en la tarea de async_tcp y el tiempo de espera se
+    // revisa en la tarea de red; el mutex evita abortar a mitad de un bloque
+    SemaphoreHandle_t lock;
+
+    size_t expectedSize;
+    unsigned long uploadStartMillis;
+    volatile unsigned long lastChunkMillis;
+    int lastPercent;
+
+    volatile unsigned long restartAt;
+    std::function<void()> beforeRestart;
+
+    static UploadStatus* statusOf(AsyncWebServerRequest* request) {
+        return static_cast<UploadStatus*>(request->_tempObject);
+    }
+
+    // Cerrar la sesión con error; se llama con el mutex tomado. request es
+    // nullptr cuando la sesión se aborta fuera de su petición
+    void fail(AsyncWebServerRequest* request, const char* error) {
+        stream.abort(error);
+        if (request != nullptr && statusOf(request) != nullptr) {
+            statusOf(request)->error = error;
+        }
+        ledManager->endOtaProgress(false);
+        Serial.printf("Actualización HTTP rechazada: %s\n", error);
+    }
+
+    // nullptr si la petición quedó como dueña de la sesión
+    const char* startUpload(AsyncWebServerRequest* request) {
+        // Autenticar antes de revelar si hay otra subida en curso
+        if (!request->authenticate(OTA_USERNAME, OTA_PASSWORD)) {
+            return "No autorizado";
+        }
+        uint8_t hash[FirmwareStream::HASH_SIZE];
+        if (!request->hasHeader("X-Firmware-SHA256") ||
+            !FirmwareStream::parseHash(request->getHeader("X-Firmware-SHA256")->value().c_str(), hash)) {
+            return "Falta la cabecera X-Firmware-SHA256 válida";
+        }
+        if (!stream.begin(request, hash)) {
+            return stream.getError();
+        }
+
+        // Con multipart el tamaño del archivo no se conoce; Content-Length es una cota
+        expectedSize = request->contentLength();
+        lastPercent = -1;
+        uploadStartMillis = millis();
+        lastChunkMillis = uploadStartMillis;
+
+        // Si el cliente se va a mitad de la subida, liberar la partición de
+        // inmediato. Tras una subida completa la sesión ya está cerrada y
+        // esto no hace nada
+        request->onDisconnect([this, request]() {
+            xSemaphoreTake(lock, portMAX_DELAY);
+            if (stream.owns(request)) {
+                fail(nullptr, "Cliente desconectado");
+            }
+            xSemaphoreGive(lock);
+        });
+
+        Serial.println(SystemMessages::OTA_START);
+        ledManager->beginOtaProgress();
+        return nullptr;
+    }
+
+    void writeChunk(AsyncWebServerRequest* request, uint8_t* data, size_t len) {
+        if (!stream.write(request, data, len)) {
+            fail(request, stream.getError());
+            return;
+        }
+        lastChunkMillis = millis();
+
+        if (expectedSize > 0) {
+            const int percent = min((uint64_t)stream.getReceivedBytes() * 100 / expectedSize, (uint64_t)99);
+            if (percent != lastPercent) {
+                lastPercent = percent;
+                ledManager->setOtaProgress(percent);
+            }
+        }
+    }
+
+    void finishUpload(AsyncWebServerRequest* request) {
+        UploadStatus* status = statusOf(request);
+        status->bytes = stream.getReceivedBytes();
+
+        // Verifica el hash antes de tocar la partición de arranque
+        if (!stream.finish(request)) {
+            status->error = stream.getError();
+            ledManager->endOtaProgress(false);
+            Serial.printf("Actualización HTTP descartada: %s\n", status->error);
+            return;
+        }
+
+        status->durationMs = millis() - uploadStartMillis;
+        status->succeeded = true;
+        ledManager->endOtaProgress(true);
+        Serial.println(SystemMessages::OTA_COMPLETE);
+        Serial.printf(SystemInfo::OTA_STATS_FORMAT, status->bytes, status->durationMs,
+                      status->durationMs > 0 ? status->bytes / status->durationMs : 0);
+    }
+
+    void handleUpload(AsyncWebServerRequest* request, const String& filename, size_t index,
+                      uint8_t* data, size_t len, bool final) {
+        xSemaphoreTake(lock, portMAX_DELAY);
+
+        if (index == 0 && statusOf(request) == nullptr) {
+            UploadStatus* status = static_cast<UploadStatus*>(malloc(sizeof(UploadStatus)));
+            if (status != nullptr) {
+                *status = {nullptr, 0, 0, false};
+                request->_tempObject = status;
+                status->error = startUpload(request);
+                if (status->error != nullptr) {
+                    Serial.printf("Actualización HTTP rechazada: %s\n", status->error);
+                }
+            }
+        }
+
+        // Los bloques de cualquier otra petición se ignoran
+        if (stream.owns(request)) {
+            if (len > 0) {
+                writeChunk(request, data, len);
+            }
+            if (final && stream.owns(request)) {
+                finishUpload(request);
+            }
+        }
+
+        xSemaphoreGive(lock);
+    }
+
+    void handleRequest(AsyncWebServerRequest* request) {
+        if (!request->authenticate(OTA_USERNAME, OTA_PASSWORD)) {
+            request->requestAuthentication();
+            return;
+        }
+
+        const UploadStatus* status = statusOf(request);
+        const bool succeeded = status != nullptr && status->succeeded;
+
+        StaticJsonDocument<256> doc;
+        doc["success"] = succeeded;
+        doc["bytes"] = status != nullptr ? status->bytes : 0;
+        if (succeeded) {
+            doc["durationMs"] = status->durationMs;
+            doc["kbps"] = status->durationMs > 0 ? status->bytes / status->durationMs : 0;
+            restartAt = millis() + FIRMWARE_RESTART_DELAY;
+        } else if (status == nullptr) {
+            doc["error"] = "Sin datos de firmware";
+        } else {
+            doc["error"] = status->error != nullptr ? status->error : "Subida interrumpida";
+        }
+
+        String response;
+        serializeJson(doc, response);
+        request->send(succeeded ? 200 : 400, "application/json", response);
+    }
+
+public:
+    FirmwareUpdater(LedManager* ledMgr)
+        : ledManager(ledMgr),
+          lock(nullptr),
+          expectedSize(0),
+          uploadStartMillis(0),
+          lastChunkMillis(0),
+          lastPercent(-1),
+          restartAt(0) {}
+
+    void begin(AsyncWebServer& server) {
+        lock = xSemaphoreCreateMutex();
+        server.on("/api/firmware", HTTP_POST,
+            [this](AsyncWebServerRequest* request) {
+                handleRequest(request);
+            },
+            [this](AsyncWebServerRequest* request, const String& filename, size_t index,
+                   uint8_t* data, size_t len, bool final) {
+                handleUpload(request, filename, index, data, len, final);
+            });
+    }
+
+    void handle() {
+        // Si el cliente dejó de enviar sin desconectarse, liberar la
+        // partición. Si async_tcp está escribiendo un bloque se reintenta
+        // en la siguiente vuelta
+        if (stream.isActive() && millis() - lastChunkMillis >= FIRMWARE_UPLOAD_TIMEOUT &&
+            xSemaphoreTake(lock, 0) == pdTRUE) {
+            if (stream.isActive() && millis() - lastChunkMillis >= FIRMWARE_UPLOAD_TIMEOUT) {
+                fail(nullptr, "Tiempo de espera agotado");
+            }
+            xSemaphoreGive(lock);
+        }
+
+        // Reiniciar fuera del contexto del servidor, después de enviar la respuesta
+        if (restartAt != 0 && (long)(millis() - restartAt) >= 0) {
+            Serial.println("Reiniciando con el nuevo firmware...");
+            if (beforeRestart) beforeRestart();
+            ESP.restart();
+        }
+    }
+
+    // Se llama justo antes de reiniciar, desde handle()
+    void onBeforeRestart(std::function<void()> callback) {
+        beforeRestart = callback;
+    }
+
+    bool isUploading() const {
+        return stream.isActive();
+    }
+};
+
+#endif
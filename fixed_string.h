@@ -0,0 +1,133 @@
+#ifndef FIXED_STRING_H
+#define FIXED_STRING_H
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+// Cadena de capacidad fija sin memoria dinámica. Lo que no cabe se trunca
+// (y queda marcado) en lugar de pedir más heap, así el uso continuo no
+// fragmenta la memoria como String.
+template <size_t N>
+class FixedString {
+private:
+    char buffer[N + 1];
+    size_t used;
+    bool truncated;
+
+public:
+    FixedString() : used(0), truncated(false) {
+        buffer[0] = '\0';
+    }
+
+    FixedString(const char* text) : FixedString() {
+        append(text);
+    }
+
+    void clear() {
+        used = 0;
+        truncated = false;
+        buffer[0] = '\0';
+    }
+
+    FixedString& append(char c) {
+        if (used < N) {
+            buffer[used++] = c;
+            buffer[used] = '\0';
+        } else {
+            truncated = true;
+        }
+        return *this;
+    }
+
+    FixedString& append(const char* text, size_t len) {
+        const size_t room = N - used;
+        if (len > room) {
+            len = room;
+            truncated = true;
+        }
+        memcpy(buffer + used, text, len);
+        used += len;
+        buffer[used] = '\0';
+        return *this;
+    }
+
+    FixedString& append(const char* text) {
+        return text != nullptr ? append(text, strlen(text)) : *this;
+    }
+
+    FixedString& appendf(const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        const int written = vsnprintf(buffer + used, N + 1 - used, format, args);
+        va_end(args);
+        if (written < 0) {
+            buffer[used] = '\0';
+        } else if ((size_t)written > N - used) {
+            used = N;
+            truncated = true;
+        } else {
+            used += written;
+        }
+        return *this;
+    }
+
+    // Codificación para URL (espacios como '+', el resto como %XX)
+    FixedString& appendUrlEncoded(const char* text) {
+        static const char HEX_DIGITS[] = "0123456789ABCDEF";
+        for (; text != nullptr && *text != '\0'; text++) {
+            const uint8_t c = *text;
+            if (c == ' ') {
+                append('+');
+            } else if (isalnum(c)) {
+                append((char)c);
+            } else if (N - used >= 3) {
+                append('%').append(HEX_DIGITS[c >> 4]).append(HEX_DIGITS[c & 0x0F]);
+            } else {
+                truncated = true;
+                break;
+            }
+        }
+        return *this;
+    }
+
+    FixedString& operator=(const char* text) {
+        clear();
+        return append(text);
+    }
+
+    template <size_t M>
+    FixedString& operator=(const FixedString<M>& other) {
+        clear();
+        return append(other.c_str(), other.length());
+    }
+
+    bool operator==(const char* text) const {
+        return text != nullptr && strcmp(buffer, text) == 0;
+    }
+
+    bool operator!=(const char* text) const {
+        return !(*this == text);
+    }
+
+    const char* c_str() const {
+        return buffer;
+    }
+
+    size_t length() const {
+        return used;
+    }
+
+    bool isEmpty() const {
+        return used == 0;
+    }
+
+    bool isTruncated() const {
+        return truncated;
+    }
+
+    static constexpr size_t capacity() {
+        return N;
+    }
+};
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef FONT_H
+#define FONT_H
+
+#include <Arduino.h>
+
+// Fuente proporcional de 3x5 para texto sobre la matriz, de ' ' a 'Z' (las
+// minúsculas se dibujan como mayúsculas). Cada fila es un byte: el bit 2 es
+// la columna izquierda y el bit 0 la derecha; la fila 0 es la de arriba. El
+// texto llega en UTF-8: las vocales acentuadas, la ü y la ñ son la letra
+// base más una marca en una fila extra encima, y las comillas tipográficas
+// se cambian por las simples. Cada letra ocupa solo las columnas que usa.
+namespace Font {
+    const uint8_t WIDTH = 3;
+    const uint8_t HEIGHT = 5;
+    const uint8_t ROWS = HEIGHT + 1;  // Con la fila de los acentos
+    const uint8_t SPACING = 1;        // Columnas vacías entre letras
+    const uint8_t SPACE_WIDTH = 2;
+
+    // Marcas de la fila de acentos (mismo formato que las filas)
+    const uint8_t ACUTE = 1;
+    const uint8_t DIAERESIS = 5;
+    const uint8_t TILDE = 7;
+
+    const char FIRST = ' ';
+    const char LAST = 'Z';
+
+    constexpr uint8_t GLYPHS[LAST - FIRST + 1][HEIGHT] = {
+        {0, 0, 0, 0, 0},  // ' '
+        {2, 2, 2, 0, 2},  // !
+        {5, 5, 0, 0, 0},  // "
+        {5, 7, 5, 7, 5},  // #
+        {3, 6, 2, 3, 6},  // $
+        {5, 1, 2, 4, 5},  // %
+        {2, 5, 2, 5, 3},  // &
+        {2, 2, 0, 0, 0},  // '
+        {1, 2, 2, 2, 1},  // (
+        {4, 2, 2, 2, 4},  // )
+        {0, 5, 2, 5, 0},  // *
+        {0, 2, 7, 2, 0},  // +
+        {0, 0, 0, 2, 4},  // ,
+        {0, 0, 7, 0, 0},  // -
+        {0, 0, 0, 0, 2},  // .
+        {1, 1, 2, 4, 4},  // /
+        {7, 5, 5, 5, 7},  // 0
+        {2, 6, 2, 2, 7},  // 1
+        {7, 1, 7, 4, 7},  // 2
+        {7, 1, 3, 1, 7},  // 3
+        {5, 5, 7, 1, 1},  // 4
+        {7, 4, 7, 1, 7},  // 5
+        {7, 4, 7, 5, 7},  // 6
+        {7, 1, 2, 2, 2},  // 7
+        {7, 5, 7, 5, 7},  // 8
+        {7, 5, 7, 1, 7},  // 9
+        {0, 2, 0, 2, 0},  // :
+        {0, 2, 0, 2, 4},  // ;
+        {1, 2, 4, 2, 1},  // <
+        {0, 7, 0, 7, 0},  // =
+        {4, 2, 1, 2, 4},  // >
+        {7, 1, 3, 0, 2},  // ?
+        {7, 5, 7, 4, 7},  // @
+        {2, 5, 7, 5, 5},  // A
+        {6, 5, 6, 5, 6},  // B
+        {3, 4, 4, 4, 3},  // C
+        {6, 5, 5, 5, 6},  // D
+        {7, 4, 6, 4, 7},  // E
+        {7, 4, 6, 4, 4},  // F
+        {3, 4, 5, 5, 3},  // G
+        {5, 5, 7, 5, 5},  // H
+        {7, 2, 2, 2, 7},  // I
+        {1, 1, 1, 5, 2},  // J
+        {5, 5, 6, 5, 5},  // K
+        {4, 4, 4, 4, 7},  // L
+        {5, 7, 7, 5, 5},  // M
+        {6, 5, 5, 5, 5},  // N
+        {2, 5, 5, 5, 2},  // O
+        {6, 5, 6, 4, 4},  // P
+        {2, 5, 5, 6, 3},  // Q
+        {6, 5, 6, 5, 5},  // R
+        {3, 4, 2, 1, 6},  // S
+        {7, 2, 2, 2, 2},  // T
+        {5, 5, 5, 5, 7},  // U
+        {5, 5, 5, 5, 2},  // V
+        {5, 5, 7, 7, 5},  // W
+        {5, 5, 2, 5, 5},  // X
+        {5, 5, 2, 2, 2},  // Y
+        {7, 1, 2, 4, 7}   // Z
+    };
+
+    constexpr uint8_t INVERTED_QUESTION[HEIGHT] = {2, 0, 6, 4, 7};
+    constexpr uint8_t INVERTED_EXCLAMATION[HEIGHT] = {2, 0, 2, 2, 2};
+
+    constexpr const uint8_t* ascii(char c) {
+        return GLYPHS[c - FIRST];
+    }
+
+    // Caracteres fuera de ASCII que se pueden dibujar
+    struct Extended {
+        uint16_t code;
+        const uint8_t* rows;
+        uint8_t accent;
+    };
+
+    constexpr Extended EXTENDED[] = {
+        {0xE1, ascii('A'), ACUTE}, {0xE9, ascii('E'), ACUTE}, {0xED, ascii('I'), ACUTE},
+        {0xF3, ascii('O'), ACUTE}, {0xFA, ascii('U'), ACUTE}, {0xFC, ascii('U'), DIAERESIS},
+        {0xF1, ascii('N'), TILDE},
+        {0xC1, ascii('A'), ACUTE}, {0xC9, ascii('E'), ACUTE}, {0xCD, ascii('I'), ACUTE},
+        {0xD3, ascii('O'), ACUTE}, {0xDA, ascii('U'), ACUTE}, {0xDC, ascii('U'), DIAERESIS},
+        {0xD1, ascii('N'), TILDE},
+        {0xBF, INVERTED_QUESTION, 0}, {0xA1, INVERTED_EXCLAMATION, 0},
+        {0xAB, ascii('"'), 0}, {0xBB, ascii('"'), 0},
+        {0x2018, ascii('\''), 0}, {0x2019, ascii('\''), 0},
+        {0x201C, ascii('"'), 0}, {0x201D, ascii('"'), 0},
+        {0x2013, ascii('-'), 0}, {0x2014, ascii('-'), 0}, {0x2026, ascii('.'), 0}
+    };
+
+    // Un carácter listo para dibujar: solo las columnas [first, first + width)
+    struct Glyph {
+        const uint8_t* rows;
+        uint8_t accent;
+        uint8_t first;
+        uint8_t width;
+    };
+
+    // Siguiente punto de código UTF-8; una secuencia inválida cuenta como un
+    // byte desconocido
+    inline uint32_t decodeUtf8(const char*& p) {
+        const uint8_t lead = *p++;
+        if (lead < 0x80) return lead;
+
+        uint8_t extra = lead >= 0xF0 ? 3 : (lead >= 0xE0 ? 2 : (lead >= 0xC0 ? 1 : 0));
+        uint32_t code = lead & (0x3F >> extra);
+        if (extra == 0) return 0xFFFD;
+        for (; extra > 0; extra--) {
+            const uint8_t next = *p;
+            if ((next & 0xC0) != 0x80) return 0xFFFD;
+            code = (code << 6) | (next & 0x3F);
+            p++;
+        }
+        return code;
+    }
+
+    // Decodificar el siguiente carácter de p; false al final de la cadena.
+    // Lo que la fuente no tiene se dibuja como '?'.
+    inline bool next(const char*& p, Glyph& glyph) {
+        if (*p == '\0') return false;
+
+        uint32_t code = decodeUtf8(p);
+        if (code >= 'a' && code <= 'z') code -= 'a' - 'A';
+
+        glyph.accent = 0;
+        glyph.rows = nullptr;
+        if (code >= (uint8_t)FIRST && code <= (uint8_t)LAST) {
+            glyph.rows = ascii(code);
+        } else {
+            for (const Extended& extended : EXTENDED) {
+                if (extended.code == code) {
+                    glyph.rows = extended.rows;
+                    glyph.accent = extended.accent;
+                    break;
+                }
+            }
+        }
+        if (glyph.rows == nullptr) glyph.rows = ascii('?');
+
+        uint8_t used = glyph.accent;
+        for (uint8_t row = 0; row < HEIGHT; row++) {
+            used |= glyph.rows[row];
+        }
+        if (used == 0) {
+            glyph.first = 0;
+            glyph.width = SPACE_WIDTH;
+            return true;
+        }
+        const uint8_t left = WIDTH - (32 - __builtin_clz(used));  // Primera columna usada
+        const uint8_t right = WIDTH - 1 - __builtin_ctz(used);
+        glyph.first = left;
+        glyph.width = right - left + 1;
+        return true;
+    }
+
+    // Columna del glifo como bits de fila: bit 0 = fila de acentos, bits 1 a
+    // HEIGHT = filas de la letra
+    inline uint8_t column(const Glyph& glyph, uint8_t x) {
+        const uint8_t bit = 1 << (WIDTH - 1 - (glyph.first + x));
+        uint8_t bits = glyph.accent & bit ? 1 : 0;
+        for (uint8_t row = 0; row < HEIGHT; row++) {
+            if (glyph.rows[row] & bit) bits |= 2 << row;
+        }
+        return bits;
+    }
+
+    // Ancho en columnas de un texto, con el espacio entre letras
+    inline uint16_t measure(const char* text) {
+        uint16_t width = 0;
+        Glyph glyph;
+        while (next(text, glyph)) {
+            width += glyph.width + SPACING;
+        }
+        return width > 0 ? width - SPACING : 0;
+    }
+}
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef FRAME_METRICS_H
+#define FRAME_METRICS_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "effect_arena.h"
+
+// Etapas de LedManager::handle() que se miden por separado
+enum FrameStage {
+    STAGE_DRAIN,     // Comandos pendientes (cambio de efecto, patrones)
+    STAGE_EFFECT,    // Actualización del efecto
+    STAGE_POST,      // Post-procesado (brillo, copia para la vista previa)
+    STAGE_SHOW,      // Entrega a la tarea de salida (espera el envío anterior)
+    STAGE_TOTAL,     // Frame completo
+    STAGE_COUNT
+};
+
+// Histograma de cubetas fijas en microsegundos. Las cubetas crecen en
+// medias octavas desde 32 us (32, 48, 64, 96, 128...), así que registrar
+// un valor cuesta un clz y unos desplazamientos. Los contadores son de 16
+// bits: al saturarse todos se dividen entre dos, lo que conserva las
+// proporciones (y por lo tanto los percentiles).
+class StageHistogram {
+public:
+    static const uint8_t BUCKETS = 22;   // Hasta ~65 ms
+    static const uint8_t BASE_SHIFT = 5; // Primera cubeta: < 48 us
+
+private:
+    uint16_t buckets[BUCKETS];
+    uint32_t maxMicros;
+
+    static uint8_t bucketFor(uint32_t micros) {
+        if (micros < (1u << BASE_SHIFT)) return 0;
+        const uint8_t octave = 31 - __builtin_clz(micros);
+        const uint8_t half = (micros >> (octave - 1)) & 1;
+        const uint8_t index = (octave - BASE_SHIFT) * 2 + half;
+        return index < BUCKETS ? index : BUCKETS - 1;
+    }
+
+    // Límite superior de la cubeta (lo que se reporta como percentil)
+    static uint32_t bucketLimit(uint8_t index) {
+        const uint8_t next = index + 1;
+        const uint32_t base = 1u << (BASE_SHIFT + next / 2);
+        return next & 1 ? base + base / 2 : base;
+    }
+
+public:
+    StageHistogram() {
+        reset();
+    }
+
+    void reset() {
+        memset(buckets, 0, sizeof(buckets));
+        maxMicros = 0;
+    }
+
+    void record(uint32_t micros) {
+        const uint8_t index = bucketFor(micros);
+        if (buckets[index] == UINT16_MAX) {
+            for (uint8_t i = 0; i < BUCKETS; i++) {
+                buckets[i] >>= 1;
+            }
+        }
+        buckets[index]++;
+        if (micros > maxMicros) maxMicros = micros;
+    }
+
+    // Percentil (0-100) aproximado al límite de su cubeta
+    uint32_t percentile(uint8_t percent) const {
+        uint32_t total = 0;
+        for (uint8_t i = 0; i < BUCKETS; i++) {
+            total += buckets[i];
+        }
+        if (total == 0) return 0;
+
+        const uint32_t target = (total * percent + 99) / 100;
+        uint32_t seen = 0;
+        for (uint8_t i = 0; i < BUCKETS; i++) {
+            seen += buckets[i];
+            if (seen >= target) {
+                return min(bucketLimit(i), maxMicros);
+            }
+        }
+        return maxMicros;
+    }
+
+    uint32_t getMax() const {
+        return maxMicros;
+    }
+};
+
+// Métricas por efecto de cada etapa del frame. El render escribe con los
+// ciclos del CPU; el reinicio pedido desde la web se aplica en el render
+// para no competir con él. Los frames de una transición (dos efectos
+// renderizados y mezclados) se cuentan aparte.
+class FrameMetrics {
+public:
+    static const uint8_t TRANSITION = OFF + 1;
+    static const uint8_t SLOT_COUNT = TRANSITION + 1;
+
+    struct EffectMetrics {
+        StageHistogram stages[STAGE_COUNT];
+        uint32_t frames;
+        uint32_t deadlineMisses;
+    };
+
+private:
+    EffectMetrics effects[SLOT_COUNT];
+    volatile bool resetRequested;
+    uint32_t cyclesPerMicro;
+
+    uint32_t toMicros(uint32_t cycles) const {
+        return cycles / cyclesPerMicro;
+    }
+
+public:
+    FrameMetrics() : resetRequested(true), cyclesPerMicro(240) {}
+
+    void begin() {
+        cyclesPerMicro = max(ESP.getCpuFreqMHz(), (uint32_t)1);
+    }
+
+    static uint32_t now() {
+        return ESP.getCycleCount();
+    }
+
+    // Marcas de ciclo al inicio de cada etapa y al final del frame. slot es
+    // el LedEffect renderizado o TRANSITION. Devuelve lo que tardó el frame
+    // en us, entrega incluida; el envío por el cable (LED_WIRE_US) corre en
+    // la tarea de salida mientras se renderiza el siguiente, así que no
+    // cuenta.
+    uint32_t record(uint8_t slot, const uint32_t (&marks)[STAGE_TOTAL + 1]) {
+        if (resetRequested) {
+            for (uint8_t i = 0; i < SLOT_COUNT; i++) {
+                for (uint8_t s = 0; s < STAGE_COUNT; s++) {
+                    effects[i].stages[s].reset();
+                }
+                effects[i].frames = 0;
+                effects[i].deadlineMisses = 0;
+            }
+            resetRequested = false;
+        }
+
+        EffectMetrics& metrics = effects[slot < SLOT_COUNT ? slot : (uint8_t)OFF];
+        for (uint8_t s = 0; s < STAGE_TOTAL; s++) {
+            metrics.stages[s].record(toMicros(marks[s + 1] - marks[s]));
+        }
+        const uint32_t total = toMicros(marks[STAGE_TOTAL] - marks[0]);
+        metrics.stages[STAGE_TOTAL].record(total);
+        metrics.frames++;
+        if (total > FRAME_DEADLINE_US) {
+            metrics.deadlineMisses++;
+        }
+        return total;
+    }
+
+    void requestReset() {
+        resetRequested = true;
+    }
+
+    const EffectMetrics& get(uint8_t slot) const {
+        return effects[slot];
+    }
+
+    static const char* slotName(uint8_t slot) {
+        return slot == TRANSITION ? "transition" : effectName(static_cast<LedEffect>(slot));
+    }
+
+    static const char* stageName(uint8_t stage) {
+        switch (stage) {
+            case STAGE_DRAIN: return "drain";
+            case STAGE_EFFECT: return "effect";
+            case STAGE_POST: return "post";
+            case STAGE_SHOW: return "show";
+            case STAGE_TOTAL: return "total";
+            default: return "unknown";
+        }
+    }
+
+    // Campos sin llaves externas, para componerlos dentro de /api/metrics:
+    // "deadlineUs":..,"wireUs":..,"effects":{"fire":{"frames":..,"stages":{"show":{p50,p99,max}}}}
+    void printFields(Print& out) const {
+        out.printf("\"deadlineUs\":%lu,\"wireUs\":%lu,\"effects\":{", FRAME_DEADLINE_US, LED_WIRE_US);
+        bool first = true;
+        for (uint8_t i = 0; i < SLOT_COUNT; i++) {
+            const EffectMetrics& metrics = effects[i];
+            if (metrics.frames == 0) continue;
+
+            out.printf("%s\"%s\":{\"frames\":%u,\"deadlineMisses\":%u,\"stages\":{",
+                       first ? "" : ",", slotName(i),
+                       metrics.frames, metrics.deadlineMisses);
+            for (uint8_t s = 0; s < STAGE_COUNT; s++) {
+                const StageHistogram& histogram = metrics.stages[s];
+                out.printf("%s\"%s\":{\"p50\":%u,\"p99\":%u,\"max\":%u}", s > 0 ? "," : "",
+                           stageName(s), histogram.percentile(50), histogram.percentile(99),
+                           histogram.getMax());
+            }
+            out.print("}}");
+            first = false;
+        }
+        out.print("}");
+    }
+};
+
+#endif
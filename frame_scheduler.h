@@ -0,0 +1,199 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Planificador de frames con paso fijo. Los frames de pantalla se anclan
+// a una rejilla de FRAME_INTERVAL_US (no a "ahora + 20 ms", que deriva), y
+// el tiempo transcurrido se acumula para avanzar la simulación del efecto
+// en pasos de su propio intervalo. Cada ranura de efecto (la entrante y la
+// saliente de una transición, y una por capa) lleva su propio acumulador.
+// Todas las funciones reciben el tiempo actual en microsegundos, así que se
+// pueden alimentar con un reloj falso.
+//
+// También gobierna la calidad: recordFrameCost() recibe lo que costó cada
+// frame en el render (el envío a los LEDs va aparte, ver led_output.h) y, si en una ventana de QUALITY_WINDOW frames hubo demasiados
+// atrasos, baja un nivel; tras QUALITY_RECOVERY_WINDOWS ventanas sin
+// atrasos prueba a subir. El costo se pasa como argumento, así que se
+// pueden inyectar costos artificiales.
+class FrameScheduler {
+public:
+    static const uint8_t BASE_SLOTS = 2;
+    static const uint8_t SLOTS = BASE_SLOTS + OVERLAY_LAYERS;
+
+    struct Stats {
+        uint32_t frames;
+        uint32_t skippedFrames;    // Frames descartados por ir atrasados
+        uint32_t droppedSteps;     // Pasos de simulación descartados
+        uint32_t maxJitterMicros;  // Retraso máximo respecto a la rejilla
+        uint32_t totalJitterMicros;
+        uint32_t qualityDrops;     // Bajadas de calidad
+        uint32_t qualityRaises;    // Subidas de calidad
+    };
+
+private:
+    bool started;
+    uint32_t nextFrame;
+    uint32_t lastFrame;
+    uint32_t accumulators[SLOTS];
+    volatile bool resetRequested;
+    Stats stats;
+
+    QualityTier quality;
+    uint8_t windowFrames;
+    uint8_t windowMisses;
+    uint8_t cleanWindows;
+
+    void clearStats() {
+        memset(&stats, 0, sizeof(stats));
+    }
+
+public:
+    FrameScheduler()
+        : started(false),
+          nextFrame(0),
+          lastFrame(0),
+          resetRequested(false),
+          quality(QUALITY_FULL),
+          windowFrames(0),
+          windowMisses(0),
+          cleanWindows(0) {
+        memset(accumulators, 0, sizeof(accumulators));
+        clearStats();
+    }
+
+    // true si toca dibujar un frame; acumula el tiempo transcurrido
+    bool frameDue(uint32_t now) {
+        if (!started) {
+            started = true;
+            nextFrame = now;
+            lastFrame = now;
+        }
+
+        const int32_t late = (int32_t)(now - nextFrame);
+        if (late < 0) return false;
+
+        if (resetRequested) {
+            clearStats();
+            resetRequested = false;
+        }
+
+        // Muy atrasados: saltar los frames perdidos en lugar de encadenarlos
+        if ((uint32_t)late >= FRAME_INTERVAL_US * MAX_FRAME_LAG) {
+            stats.skippedFrames += late / FRAME_INTERVAL_US;
+            nextFrame = now + FRAME_INTERVAL_US;
+        } else {
+            nextFrame += FRAME_INTERVAL_US;
+        }
+
+        stats.frames++;
+        stats.totalJitterMicros += late;
+        if ((uint32_t)late > stats.maxJitterMicros) {
+            stats.maxJitterMicros = late;
+        }
+
+        for (uint8_t slot = 0; slot < SLOTS; slot++) {
+            accumulators[slot] += now - lastFrame;
+        }
+        lastFrame = now;
+        return true;
+    }
+
+    // Pasos de simulación que corresponden a este frame (0 = en pausa)
+    uint8_t stepsDue(uint8_t slot, uint32_t stepInterval) {
+        uint32_t& accumulator = accumulators[slot];
+        if (stepInterval == 0) {
+            accumulator = 0;
+            return 0;
+        }
+
+        uint8_t steps = 0;
+        while (accumulator >= stepInterval && steps < MAX_STEPS_PER_FRAME) {
+            accumulator -= stepInterval;
+            steps++;
+        }
+
+        // Bajo sobrecarga no se intenta recuperar todo el atraso
+        if (accumulator >= stepInterval) {
+            stats.droppedSteps += accumulator / stepInterval;
+            accumulator %= stepInterval;
+        }
+        return steps;
+    }
+
+    // Fracción (0-256) del paso en curso ya transcurrida, para interpolar
+    // entre los dos últimos estados. Sin simulación se muestra el actual.
+    uint16_t stepBlend(uint8_t slot, uint32_t stepInterval) const {
+        if (stepInterval == 0) return 256;
+        return (uint64_t)accumulators[slot] * 256 / stepInterval;
+    }
+
+    // Un efecto nuevo empieza sin tiempo acumulado
+    void resetSimulation(uint8_t slot) {
+        accumulators[slot] = 0;
+    }
+
+    // Costo del frame en el render en microsegundos; tiers = niveles
+    // del efecto activo
+    void recordFrameCost(uint32_t micros, uint8_t tiers) {
+        if (micros > FRAME_DEADLINE_US) windowMisses++;
+        if (++windowFrames < QUALITY_WINDOW) return;
+
+        if (windowMisses >= QUALITY_MISS_LIMIT) {
+            cleanWindows = 0;
+            if (quality + 1 < tiers) {
+                quality = static_cast<QualityTier>(quality + 1);
+                stats.qualityDrops++;
+            }
+        } else if (windowMisses > 0) {
+            cleanWindows = 0;  // Las ventanas limpias tienen que ser seguidas
+        } else if (quality > QUALITY_FULL && ++cleanWindows >= QUALITY_RECOVERY_WINDOWS) {
+            cleanWindows = 0;
+            quality = static_cast<QualityTier>(quality - 1);
+            stats.qualityRaises++;
+        }
+        windowFrames = 0;
+        windowMisses = 0;
+    }
+
+    // Cada efecto nuevo arranca con calidad completa
+    void resetQuality() {
+        quality = QUALITY_FULL;
+        windowFrames = 0;
+        windowMisses = 0;
+        cleanWindows = 0;
+    }
+
+    QualityTier getQuality() const {
+        return quality;
+    }
+
+    static const char* qualityName(QualityTier tier) {
+        return tier == QUALITY_FULL ? "full" : "reduced";
+    }
+
+    // Se aplica en el siguiente frame, desde el render
+    void requestReset() {
+        resetRequested = true;
+    }
+
+    const Stats& getStats() const {
+        return stats;
+    }
+
+    uint32_t getAverageJitter() const {
+        return stats.frames > 0 ? stats.totalJitterMicros / stats.frames : 0;
+    }
+
+    void printJson(Print& out) const {
+        out.printf("{\"intervalUs\":%lu,\"frames\":%u,\"skippedFrames\":%u,\"droppedSteps\":%u,"
+                   "\"jitterAvgUs\":%u,\"jitterMaxUs\":%u,\"quality\":\"%s\","
+                   "\"qualityDrops\":%u,\"qualityRaises\":%u}",
+                   FRAME_INTERVAL_US, stats.frames, stats.skippedFrames, stats.droppedSteps,
+                   getAverageJitter(), stats.maxJitterMicros, qualityName(quality),
+                   stats.qualityDrops, stats.qualityRaises);
+    }
+};
+
+#endif
@@ -3,804 +3,458 @@
 
 #include <FastLED.h>
 #include "config.h"
-#include <NTPClient.h>
-#include <WiFiUdp.h>
+#include "boot_timeline.h"
+#include "matrix_geometry.h"
+#include "effects.h"
+#include "effect_arena.h"
+#include "frame_metrics.h"
+#include "frame_scheduler.h"
+#include "pixel_ops.h"
+#include "param_ramp.h"
+#include "power_limiter.h"
+#include "output_pipeline.h"
+#include "led_output.h"
+#include "symmetry.h"
+#include "post_fx.h"
+#include "effect_layers.h"
+#include "text_overlay.h"
+#include "led_settings.h"
 #include <TimeLib.h>
 #include <ArduinoJson.h>
 #include <ArduinoJson.hpp>
 
 class LedManager {
 private:
-    CRGB leds[NUM_LEDS];
+    alignas(4) CRGB leds[NUM_LEDS];
     LedEffect currentEffect;
-    uint8_t brightness;
+    ParamRamp brightness;
     bool isOn;
-    unsigned long lastUpdate;
-    String rainbowType;
-
-    // Variables para efectos
-    uint8_t hue = 0;
-    uint8_t saturation = 255;
-    uint8_t breathVal = 0;
-    bool breathingUp = true;
-
-    // Variables para pasaje
-    uint8_t book;
-    uint8_t chapter;
-    uint8_t verse;
-
-    // Variables para el Juego de la Vida
-    bool lifeGrid[26][27];
-    bool nextGrid[26][27];
-    CRGB lifeColor = CRGB(255, 255, 255);
-    unsigned long lastLifeUpdate = 0;
-    static const unsigned long LIFE_UPDATE_INTERVAL = 100;
-
-    // Constantes para la matriz
-    static const uint8_t LED_WIDTH = 27;
-    static const uint8_t LED_HEIGHT = 26;
-    
-    static const uint8_t PALETTE_SIZE = 6;
+    bool firstFrameShown = false;
+
+    // Se incrementa en cada cambio de configuración (lo observa SettingsManager)
+    volatile uint32_t changeCounter = 0;
+
+    // Copia del frame para la vista previa web (la solicita otra tarea)
+    uint8_t* volatile snapshotTarget = nullptr;
+    volatile bool snapshotReady = false;
+
+    // Configuración de los efectos (brillo, tono y saturación van en rampa)
+    ParamRamp hue{0, true};
+    ParamRamp saturation{255};
+    RainbowType rainbowType = RAINBOW_DIAGONAL;
+    uint8_t currentFirePalette = 0;
+
+    // Pasaje del día (libro << 16 | capítulo << 8 | versículo): llega de la
+    // tarea del versículo en una sola escritura, nunca a medias
+    volatile uint32_t passage = 0;
+
+    static constexpr const char* RAINBOW_TYPES[RAINBOW_TYPE_COUNT] = {"diagonal", "horizontal", "vertical", "circular"};
 
     bool autoRestart = true;
-    bool isStaticPattern = false;
 
     float lifeSpeed = 1.0;
-    const float SPEED_VALUES[6] = {0, 0.25, 0.5, 0.75, 1.0, 2.0};
-    unsigned long LIFE_BASE_INTERVAL = 100;
-
-    // Variables para el reloj
-    WiFiUDP ntpUDP;
-    NTPClient timeClient;
-    bool timeInitialized = false;
-    const CRGB CLOCK_COLOR = CRGB(255, 255, 255);  // Blanco fijo
-    const CRGB PASSAGE_COLOR = CRGB(0, 255, 255);  // Cian fijo
-    
-    
-        const CRGB firePalettes[6][PALETTE_SIZE] = {
-        { // Rojo
-            CRGB(0, 0, 0),        // negro
-            CRGB(128, 0, 0),      // rojo oscuro
-            CRGB(179, 0, 0),      // rojo medio
-            CRGB(255, 0, 0),      // rojo
-            CRGB(255, 64, 0),     // rojo-naranja
-            CRGB(255, 128, 0)     // naranja
-        },
-        { // Rojo claro/Naranja
-            CRGB(0, 0, 0),        // negro
-            CRGB(255, 0, 0),      // rojo
-            CRGB(255, 64, 0),     // rojo-naranja
-            CRGB(255, 128, 0),    // naranja
-            CRGB(255, 192, 64),   // naranja claro
-            CRGB(255, 255, 128)   // amarillo claro
-        },
-        { // Amarillo
-            CRGB(0, 0, 0),        // negro
-            CRGB(128, 64, 0),     // ámbar oscuro
-            CRGB(192, 128, 0),    // ámbar
-            CRGB(255, 192, 0),    // amarillo oscuro
-            CRGB(255, 255, 0),    // amarillo
-            CRGB(255, 255, 128)   // amarillo claro
-        },
-        { // Verde
-            CRGB(0, 0, 0),        // negro
-            CRGB(0, 32, 0),       // verde muy oscuro
-            CRGB(0, 64, 0),       // verde oscuro
-            CRGB(0, 128, 0),      // verde medio
-            CRGB(32, 192, 0),     // verde claro
-            CRGB(64, 255, 0)      // verde brillante
-        },
-        { // Azul
-            CRGB(0, 0, 0),        // negro
-            CRGB(0, 0, 128),      // azul oscuro
-            CRGB(0, 0, 192),      // azul medio
-            CRGB(0, 0, 255),      // azul
-            CRGB(0, 128, 255),    // azul claro
-            CRGB(128, 192, 255)   // azul muy claro
-        },
-        { // Negro
-            CRGB(0, 0, 0),        // negro
-            CRGB(16, 16, 16),     // gris muy oscuro
-            CRGB(32, 32, 32),     // gris oscuro
-            CRGB(64, 64, 64),     // gris medio
-            CRGB(96, 96, 96),     // gris claro
-            CRGB(128, 128, 128)   // gris
-        }
-    };
-
-    // Patrón único para los dígitos (5x3)
-    static constexpr bool DIGIT_PATTERNS[10][5][3] = {
-        { // 0
-            {1,1,1},
-            {1,0,1},
-            {1,0,1},
-            {1,0,1},
-            {1,1,1}
-        },
-        { // 1
-            {0,1,0},
-            {1,1,0},
-            {0,1,0},
-            {0,1,0},
-            {1,1,1}
-        },
-        { // 2
-            {1,1,1},
-            {0,0,1},
-            {1,1,1},
-            {1,0,0},
-            {1,1,1}
-        },
-        { // 3
-            {1,1,1},
-            {0,0,1},
-            {0,1,1},
-            {0,0,1},
-            {1,1,1}
-        },
-        { // 4
-            {1,0,1},
-            {1,0,1},
-            {1,1,1},
-            {0,0,1},
-            {0,0,1}
-        },
-        { // 5
-            {1,1,1},
-            {1,0,0},
-            {1,1,1},
-            {0,0,1},
-            {1,1,1}
-        },
-        { // 6
-            {1,1,1},
-            {1,0,0},
-            {1,1,1},
-            {1,0,1},
-            {1,1,1}
-        },
-        { // 7
-            {1,1,1},
-            {0,0,1},
-            {0,1,0},
-            {0,1,0},
-            {0,1,0}
-        },
-        { // 8
-            {1,1,1},
-            {1,0,1},
-            {1,1,1},
-            {1,0,1},
-            {1,1,1}
-        },
-        { // 9
-            {1,1,1},
-            {1,0,1},
-            {1,1,1},
-            {0,0,1},
-            {1,1,1}
+    static constexpr float SPEED_VALUES[6] = {0, 0.25, 0.5, 0.75, 1.0, 2.0};
+    uint8_t currentLifePattern = LifeEffect::RANDOM;
+
+    // El estado de trabajo de cada efecto vive en una arena. Las dos
+    // primeras son del efecto base: durante una transición el saliente sigue
+    // vivo en una mientras el entrante arranca desde cero en la otra. Las
+    // siguientes son de las capas (ver effect_layers.h), con la misma ranura
+    // del planificador. Los cambios llegan desde otras tareas y se aplican
+    // al inicio del siguiente frame.
+    EffectArena arenas[FrameScheduler::SLOTS];
+    uint8_t activeSlot = 0;
+    Effect* effect = nullptr;
+    LedEffect activeEffect = OFF;
+    LedEffect slotEffects[FrameScheduler::SLOTS];
+
+    // Capas sobre el efecto base: configuración pedida, compositor (guarda la
+    // matriz de giro de tono) y un frame compartido donde se dibuja cada una
+    LayerConfig layers[OVERLAY_LAYERS];
+    LayerCompositor compositors[OVERLAY_LAYERS];
+    alignas(4) CRGB layerFrame[NUM_LEDS];
+    TextOverlay overlay;  // Texto sobre todas las capas
+    SymmetryMode symmetry[OFF] = {};  // Por efecto; se lee en cada frame
+    PostFxSettings postFxSettings[OFF];
+    PostFx postFx;
+    volatile bool lifePatternRequested = false;
+    FrameScheduler scheduler;
+    PowerLimiter power;
+    OutputPipeline output;  // Buffers que envía FastLED (ver output_pipeline.h)
+    LedOutput ledOutput;    // Tarea que llama a FastLED.show() (ver led_output.h)
+
+    // Transición: el efecto saliente se dibuja en transitionFrame y se
+    // mezcla con el entrante, que se dibuja en leds
+    alignas(4) CRGB transitionFrame[NUM_LEDS];
+    Effect* outgoing = nullptr;
+    bool transitioning = false;
+    uint32_t transitionStart = 0;
+    uint32_t transitionMicros = 0;
+    uint16_t transitionMs = EFFECT_TRANSITION_MS;
+
+    FrameMetrics metrics;
+
+    // Variables para la actualización OTA
+    volatile bool otaActive = false;
+    volatile uint8_t otaProgress = 0;
+    int16_t otaShownProgress = -1;
+    const CRGB OTA_PROGRESS_COLOR = CRGB(0, 96, 255);  // Azul
+    const CRGB OTA_DONE_COLOR = CRGB(0, 255, 0);       // Verde
+    const CRGB OTA_TRACK_COLOR = CRGB(8, 8, 8);        // Gris tenue
+
+    EffectParams effectParams() const {
+        EffectParams params;
+        params.hue = hue.get();
+        params.saturation = saturation.get();
+        params.firePalette = currentFirePalette;
+        params.rainbowType = rainbowType;
+        params.lifePattern = currentLifePattern;
+        params.lifeSpeed = lifeSpeed;
+        params.autoRestart = autoRestart;
+        const uint32_t currentPassage = passage;
+        params.book = currentPassage >> 16;
+        params.chapter = currentPassage >> 8;
+        params.verse = currentPassage;
+        params.stepBlend = 256;
+        params.quality = QUALITY_FULL;
+        params.regionWidth = Matrix::WIDTH;
+        params.regionHeight = Matrix::HEIGHT;
+        return params;
+    }
+
+    // Construir el efecto pedido en la otra arena. El activo pasa a ser el
+    // saliente; si ya había una transición en curso, su saliente se destruye.
+    void switchEffect(LedEffect next, uint32_t now) {
+        const uint8_t outgoingSlot = activeSlot;
+        activeSlot ^= 1;
+        effect = emplaceEffect(arenas[activeSlot], next);
+        activeEffect = next;
+        slotEffects[activeSlot] = next;
+        scheduler.resetSimulation(activeSlot);
+        scheduler.resetQuality();
+        if (effect != nullptr) {
+            effect->begin(effectParams());
+        }
+
+        transitionMicros = (uint32_t)transitionMs * 1000;
+        if (transitionMicros > 0) {
+            outgoing = arenas[outgoingSlot].get();
+            transitioning = true;
+            transitionStart = now;
+        } else {
+            finishTransition();
         }
-    };
+    }
 
-    static constexpr bool MINI_DIGITS[10][3][2] = {
-        { // 0
-            {0,0},
-            {0,0},
-            {1,1}
-        },
-        { // 1
-            {1,0},
-            {1,0},
-            {1,0}
-        },
-        { // 2
-            {1,0},
-            {0,0},
-            {0,1}
-        },
-        { // 3
-            {0,1},
-            {0,0},
-            {1,1}
-        },
-        { // 4
-            {0,1},
-            {1,1},
-            {0,1}
-        },
-        { // 5
-            {1,1},
-            {1,0},
-            {1,1}
-        },
-        { // 6
-            {1,0},
-            {1,1},
-            {1,1}
-        },
-        { // 7
-            {1,1},
-            {0,1},
-            {0,1}
-        },
-        { // 8
-            {1,1},
-            {1,1},
-            {1,1}
-        },
-        { // 9
-            {1,1},
-            {1,1},
-            {0,1}
-        }
-    };
+    void finishTransition() {
+        arenas[activeSlot ^ 1].clear();
+        outgoing = nullptr;
+        transitioning = false;
+    }
 
-    uint8_t currentFirePalette = 0;
-    uint8_t firePixels[NUM_LEDS];
-
-    enum LifePattern {
-        RANDOM,
-        BLOCK,
-        BLINKER,
-        GLIDER,
-        TOAD,
-        BEACON,
-        LWSS
-    };
-    
-
-    String urlEncode(String str) {
-        String encodedString = "";
-        char c;
-        char code0;
-        char code1;
-        for (int i = 0; i < str.length(); i++) {
-            c = str.charAt(i);
-            if (c == ' ') {
-                encodedString += '+';
-            } else if (isalnum(c)) {
-                encodedString += c;
-            } else {
-                code1 = (c & 0xf) + '0';
-                if ((c & 0xf) > 9) {
-                    code1 = (c & 0xf) - 10 + 'A';
-                }
-                c = (c >> 4) & 0xf;
-                code0 = c + '0';
-                if (c > 9) {
-                    code0 = c - 10 + 'A';
-                }
-                encodedString += '%';
-                encodedString += code0;
-                encodedString += code1;
-            }
+    // Reconstruir el generador de una capa; arranca desde cero
+    void rebuildLayer(uint8_t layer, LedEffect next) {
+        const uint8_t slot = FrameScheduler::BASE_SLOTS + layer;
+        Effect* built = emplaceEffect(arenas[slot], next);
+        slotEffects[slot] = next;
+        scheduler.resetSimulation(slot);
+        if (built != nullptr) {
+            built->begin(effectParams());
         }
-        return encodedString;
     }
-    
-    LifePattern currentLifePattern = RANDOM;
 
-        void setLifePattern(LifePattern pattern) {
-        currentLifePattern = pattern;
-        
-        // Determinar si el patrón es estático
-        isStaticPattern = (pattern == BLOCK);
-        
-        // Limpiar la matriz
-        for(uint8_t y = 0; y < LED_HEIGHT; y++) {
-            for(uint8_t x = 0; x < LED_WIDTH; x++) {
-                lifeGrid[y][x] = false;
-                nextGrid[y][x] = false;
-            }
+    // Dibujar cada capa encendida y mezclarla sobre leds[]
+    void renderLayers() {
+        for (uint8_t layer = 0; layer < OVERLAY_LAYERS; layer++) {
+            const uint8_t slot = FrameScheduler::BASE_SLOTS + layer;
+            Effect* generator = arenas[slot].get();
+            if (generator == nullptr) continue;
+            const LayerConfig config = layers[layer];
+            renderSlot(slot, generator, layerFrame, config.symmetry, config.postFx);
+            compositors[layer].composite(leds, layerFrame, config);
         }
+    }
 
-        // Posición aleatoria para el patrón
-        uint8_t startX = random(5, LED_WIDTH - 5);
-        uint8_t startY = random(5, LED_HEIGHT - 5);
-
-        switch(pattern) {
-            case BLOCK:
-                lifeGrid[startY][startX] = true;
-                lifeGrid[startY][startX+1] = true;
-                lifeGrid[startY+1][startX] = true;
-                lifeGrid[startY+1][startX+1] = true;
-                break;
-
-            case BLINKER:
-                lifeGrid[startY][startX-1] = true;
-                lifeGrid[startY][startX] = true;
-                lifeGrid[startY][startX+1] = true;
-                break;
-
-            case GLIDER:
-                lifeGrid[startY-1][startX] = true;
-                lifeGrid[startY][startX+1] = true;
-                lifeGrid[startY+1][startX-1] = true;
-                lifeGrid[startY+1][startX] = true;
-                lifeGrid[startY+1][startX+1] = true;
-                break;
-
-            case TOAD:
-                lifeGrid[startY][startX-1] = true;
-                lifeGrid[startY][startX] = true;
-                lifeGrid[startY][startX+1] = true;
-                lifeGrid[startY+1][startX-2] = true;
-                lifeGrid[startY+1][startX-1] = true;
-                lifeGrid[startY+1][startX] = true;
-                break;
+    // Avanzar y dibujar el efecto base de una ranura, con la simetría y el
+    // desenfoque de ese efecto
+    void renderBase(uint8_t slot, Effect* target, CRGB* frame) {
+        const LedEffect shown = slotEffects[slot];
+        renderSlot(slot, target, frame, getSymmetry(shown), getPostFxSettings(shown));
+    }
 
-            case BEACON:
-                lifeGrid[startY][startX] = true;
-                lifeGrid[startY][startX+1] = true;
-                lifeGrid[startY+1][startX] = true;
-                lifeGrid[startY+1][startX+1] = true;
-                lifeGrid[startY+2][startX+2] = true;
-                lifeGrid[startY+2][startX+3] = true;
-                lifeGrid[startY+3][startX+2] = true;
-                lifeGrid[startY+3][startX+3] = true;
-                break;
+    // Avanzar y dibujar el efecto de una ranura (nullptr = negro)
+    void renderSlot(uint8_t slot, Effect* target, CRGB* frame, SymmetryMode symmetryMode, const PostFxSettings& fx) {
+        if (target == nullptr) {
+            scheduler.stepsDue(slot, 0);
+            fill_solid(frame, NUM_LEDS, CRGB::Black);
+            return;
+        }
 
-            case LWSS:
-                lifeGrid[startY][startX+1] = true;
-                lifeGrid[startY][startX+4] = true;
-                lifeGrid[startY+1][startX] = true;
-                lifeGrid[startY+2][startX] = true;
-                lifeGrid[startY+2][startX+4] = true;
-                lifeGrid[startY+3][startX+1] = true;
-                lifeGrid[startY+3][startX+2] = true;
-                lifeGrid[startY+3][startX+3] = true;
-                break;
+        EffectParams params = effectParams();
+        params.quality = static_cast<QualityTier>(
+            min((uint8_t)scheduler.getQuality(), (uint8_t)(target->qualityTiers() - 1)));
+        const SymmetryMode mode = target->supportsSymmetry() ? symmetryMode : SYMMETRY_NONE;
+        params.regionWidth = Symmetry::regionWidth(mode);
+        params.regionHeight = Symmetry::regionHeight(mode);
 
-            case RANDOM:
-            default:
-                initLife();
-                break;
+        const uint32_t interval = target->stepInterval(params);
+        const uint8_t steps = scheduler.stepsDue(slot, interval);
+        for (uint8_t i = 0; i < steps; i++) {
+            target->step(params);
         }
+        params.stepBlend = scheduler.stepBlend(slot, interval);
+        target->render(frame, params);
+        Symmetry::replicate(frame, mode);
+        postFx.apply(frame, fx);
     }
 
-        void initLife() {
-        // Inicializar con patrón aleatorio
-        for(uint8_t y = 0; y < LED_HEIGHT; y++) {
-            for(uint8_t x = 0; x < LED_WIDTH; x++) {
-                lifeGrid[y][x] = random(2) == 1;
+    // Aplicar los comandos pendientes antes de renderizar
+    void drainCommands(uint32_t now) {
+        brightness.advance();
+        hue.advance();
+        saturation.advance();
+
+        const LedEffect requested = currentEffect;
+        if (requested != activeEffect) {
+            lifePatternRequested = false;
+            switchEffect(requested, now);
+        }
+        for (uint8_t layer = 0; layer < OVERLAY_LAYERS; layer++) {
+            const LedEffect generator = layers[layer].effect;
+            if (generator != slotEffects[FrameScheduler::BASE_SLOTS + layer]) {
+                rebuildLayer(layer, generator);
             }
         }
-    }
-
-    uint8_t countNeighbors(uint8_t x, uint8_t y) {
-        uint8_t count = 0;
-        for(int8_t i = -1; i <= 1; i++) {
-            for(int8_t j = -1; j <= 1; j++) {
-                if(i == 0 && j == 0) continue;
-                
-                int8_t newX = x + i;
-                int8_t newY = y + j;
-                
-                // Manejo de bordes toroidales
-                if(newX < 0) newX = LED_WIDTH - 1;
-                if(newX >= LED_WIDTH) newX = 0;
-                if(newY < 0) newY = LED_HEIGHT - 1;
-                if(newY >= LED_HEIGHT) newY = 0;
-                
-                if(lifeGrid[newY][newX]) count++;
+        if (lifePatternRequested) {
+            lifePatternRequested = false;
+            if (activeEffect == LIFE) {
+                static_cast<LifeEffect*>(effect)->setPattern(currentLifePattern);
             }
         }
-        return count;
     }
 
-    void updateLife() {
-        if (currentEffect != LIFE) return;
-        if (lifeSpeed == 0) return;  // Pausa
+    // Barra de progreso OTA: solo se redibuja cuando cambia el porcentaje
+    void renderOtaProgress() {
+        const uint8_t progress = otaProgress;
+        if (progress == otaShownProgress) return;
+        otaShownProgress = progress;
 
-        const unsigned long currentMillis = millis();
-        const unsigned long interval = LIFE_BASE_INTERVAL / lifeSpeed;
-        if (currentMillis - lastLifeUpdate < interval) {
-            return;
-        }
-        lastLifeUpdate = currentMillis;
-
-        // Calcular siguiente generación
-        for(uint8_t y = 0; y < LED_HEIGHT; y++) {
-            for(uint8_t x = 0; x < LED_WIDTH; x++) {
-                uint8_t neighbors = countNeighbors(x, y);
-                bool currentCell = lifeGrid[y][x];
-                
-                if(currentCell && (neighbors < 2 || neighbors > 3)) {
-                    nextGrid[y][x] = false;
-                }
-                else if(!currentCell && neighbors == 3) {
-                    nextGrid[y][x] = true;
-                }
-                else {
-                    nextGrid[y][x] = currentCell;
-                }
-            }
-        }
+        const uint8_t filled = (uint16_t)progress * Matrix::WIDTH / 100;
+        const CRGB barColor = progress >= 100 ? OTA_DONE_COLOR : OTA_PROGRESS_COLOR;
+        const uint8_t barTop = Matrix::HEIGHT / 2 + 1;
+        const uint8_t barBottom = Matrix::HEIGHT / 2 - 2;
 
-        // Actualizar grid y mostrar
-        bool hasChange = false;
-        for(uint8_t y = 0; y < LED_HEIGHT; y++) {
-            for(uint8_t x = 0; x < LED_WIDTH; x++) {
-                if(lifeGrid[y][x] != nextGrid[y][x]) hasChange = true;
-                lifeGrid[y][x] = nextGrid[y][x];
-                leds[xy(x, y)] = lifeGrid[y][x] ? lifeColor : CRGB::Black;
+        fill_solid(leds, NUM_LEDS, CRGB::Black);
+        for (uint8_t y = barBottom; y <= barTop; y++) {
+            for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+                leds[Matrix::xy(x, y)] = x < filled ? barColor : OTA_TRACK_COLOR;
             }
         }
+        present(min(brightness.getTarget(), (uint8_t)64));
+        captureSnapshot();
+    }
 
-        // Solo reiniciar si no es un patrón estático y no hay cambios
-        if(!hasChange && autoRestart) {
-            initLife();
-        }
+    // Pasar leds[] al buffer de salida y entregarlo a la tarea de salida
+    void present(uint8_t level) {
+        const uint8_t outputBrightness = output.convert(leds, level);
+        ledOutput.show(output.buffer(), outputBrightness);
+    }
+
+    // Copiar el frame recién mostrado si la vista previa lo pidió
+    void captureSnapshot() {
+        uint8_t* target = snapshotTarget;
+        if (target == nullptr) return;
+        memcpy(target, leds, sizeof(leds));
+        snapshotTarget = nullptr;
+        snapshotReady = true;
     }
 
-    void initClock() {
-        if (!timeInitialized) {
-            timeClient.begin();
-            timeClient.setTimeOffset(-6 * 3600); // UTC-6 para CDMX
-            timeInitialized = true;
+public:
+    LedManager() : 
+        currentEffect(FIRE), 
+        brightness(MAX_BRIGHTNESS), 
+        isOn(true)
+    {
+        // La tarea de salida cambia el buffer y el brillo en cada frame
+        FastLED.addLeds<WS2812B, LED_PIN, GRB>(output.buffer(), NUM_LEDS);
+        for (uint8_t i = 0; i < OFF; i++) {
+            postFxSettings[i] = {POSTFX_NONE, BLUR_RADIUS, BLOOM_THRESHOLD};
+        }
+        for (uint8_t slot = 0; slot < FrameScheduler::SLOTS; slot++) {
+            slotEffects[slot] = OFF;
+        }
+        for (uint8_t layer = 0; layer < OVERLAY_LAYERS; layer++) {
+            layers[layer] = {OFF, BLEND_NORMAL, 255, 0, MASK_NONE, SYMMETRY_NONE,
+                             {POSTFX_NONE, BLUR_RADIUS, BLOOM_THRESHOLD}};
         }
     }
 
-    void updateClock() {
-        if (currentEffect != CLOCK) return;
-        
-        timeClient.update();
-        
+    void begin() {
+        output.begin();
         FastLED.clear();
-        
-        // Obtener y mostrar la hora
-        int hours = timeClient.getHours();
-        int minutes = timeClient.getMinutes();
-        
-        if (hours > 12) hours -= 12;
-        if (hours == 0) hours = 12;
-        
-        String timeStr = (hours < 10 ? "0" : "") + String(hours) + ":" + 
-                    (minutes < 10 ? "0" : "") + String(minutes);
-
-        // Calcular posición central
-        // Ancho total = (4 dígitos * 4 espacios) + (2 espacios para los dos puntos) = 18 pixels
-        int totalWidth = (4 * 4) + 2;  // 4 dígitos de 4 pixels cada uno + 2 pixels para ':'
-        int startX = (LED_WIDTH - totalWidth) / 2;
-
-        drawTime(timeStr, startX, 3, CLOCK_COLOR);  // Usando color blanco
-        
-        // Mostrar el pasaje bíblico en cian
-        String passageStr = String(book) + ":" + 
-                          String(chapter) + ":" + 
-                          String(verse);
-        drawPassage(passageStr, 3, LED_HEIGHT - 8, PASSAGE_COLOR);  // Añadido el parámetro de color
-        
         FastLED.show();
+        ledOutput.begin();
+        overlay.begin();
+        printMemoryReport();
+        metrics.begin();
     }
 
-    // Función para dibujar la hora
-    void drawTime(String time, int x, int y, CRGB color) {
-        int xOffset = x;
-        for (char c : time) {
-            if (c >= '0' && c <= '9') {
-                drawDigit(c, xOffset, y, color);
-                xOffset += 4;  // Espacio entre dígitos
-            } else if (c == ':') {
-                drawColon(xOffset, y, color);
-                xOffset += 2;  // Espacio para los dos puntos
-            }
+    void handle() {
+        // Durante una actualización OTA solo se muestra el progreso
+        if (otaActive) {
+            renderOtaProgress();
+            return;
         }
-    }
 
-    // Función para dibujar dígitos grandes (hora)
-    void drawDigit(char digit, int x, int y, CRGB color) {
-        int idx = digit - '0';
-        if (idx < 0 || idx > 9) return;
-
-        for (int dy = 0; dy < 5; dy++) {
-            for (int dx = 0; dx < 3; dx++) {
-                if (DIGIT_PATTERNS[idx][dy][dx]) {
-                    int pixelX = x + dx;
-                    int pixelY = y + dy;
-                    if (pixelX < LED_WIDTH && pixelY < LED_HEIGHT) {
-                        leds[clockXY(pixelX, pixelY)] = color;  // Usar clockXY
-                    }
-                }
-            }
-        }
-    }
+        const uint32_t now = micros();
+        if (!scheduler.frameDue(now)) return;
 
-    // Función para dibujar dígitos pequeños (pasaje bíblico)
-    void drawMiniDigit(char digit, int x, int y, CRGB color) {
-        int idx = digit - '0';
-        if (idx < 0 || idx > 9) return;
-
-        for (int dy = 0; dy < 3; dy++) {
-            for (int dx = 0; dx < 2; dx++) {
-                if (MINI_DIGITS[idx][dy][dx]) {
-                    int pixelX = x + dx;
-                    int pixelY = y + dy;
-                    if (pixelX < LED_WIDTH && pixelY < LED_HEIGHT) {
-                        leds[clockXY(pixelX, pixelY)] = color;  // Usar clockXY
-                    }
-                }
-            }
+        if (!isOn) {
+            fill_solid(leds, NUM_LEDS, CRGB::Black);
+            present(0);
+            captureSnapshot();
+            power.recordIdle(now);
+            return;
         }
-    }
 
-    void drawColon(int x, int y, CRGB color) {
-        // Posicionar los dos puntos centrados verticalmente con respecto a los dígitos
-        // Los dígitos son de 5 pixels de alto, así que ponemos los puntos en y+1 y y+3
-        int y1 = y + 1;
-        int y2 = y + 3;
-        
-        if (y1 >= 0 && y1 < LED_HEIGHT) {
-            leds[clockXY(x, y1)] = color;
-        }
-        if (y2 >= 0 && y2 < LED_HEIGHT) {
-            leds[clockXY(x, y2)] = color;
-        }
-    }
+        // Marcas de ciclo al inicio de cada etapa (ver frame_metrics.h)
+        uint32_t marks[STAGE_TOTAL + 1];
+        marks[STAGE_DRAIN] = FrameMetrics::now();
+        drainCommands(now);
 
-    void drawPassage(String passage, int x, int y, CRGB color) {
-    int xOffset = x;
-    for (char c : passage) {
-        if (c >= '0' && c <= '9') {
-            drawMiniDigit(c, xOffset, y, color);
-            xOffset += 3;  // Espacio entre dígitos
-        } else if (c == ':') {
-            // Dibujar un solo punto para separar, más compacto
-            if (y + 1 < LED_HEIGHT) {
-                int dotY = y + 1;  // Centrar el punto verticalmente
-                leds[clockXY(xOffset, dotY)] = color;
-            }
-            xOffset += 2;  // Menor espacio para el separador
+        marks[STAGE_EFFECT] = FrameMetrics::now();
+        if (transitioning && now - transitionStart >= transitionMicros) {
+            finishTransition();
         }
-    }
-}
+        const bool blending = transitioning;
+        renderBase(activeSlot, effect, leds);
+        if (blending) {
+            renderBase(activeSlot ^ 1, outgoing, transitionFrame);
+            const uint16_t t = (uint64_t)(now - transitionStart) * 256 / transitionMicros;
+            PixelOps::lerpPixels(leds, transitionFrame, NUM_LEDS, t);
+        }
+        renderLayers();
+        const uint32_t currentPassage = passage;
+        overlay.update(currentPassage >> 16, currentPassage >> 8, currentPassage);
+        overlay.composite(leds);
 
+        marks[STAGE_POST] = FrameMetrics::now();
+        const uint8_t shownBrightness = power.limitFrame(brightness.get());
+        const uint8_t outputBrightness = output.convert(leds, shownBrightness);
+        uint32_t red, green, blue;
+        output.getChannelSums(red, green, blue);
+        power.setFrameSums(red, green, blue);
+        captureSnapshot();
 
+        // La tarea de salida envía el frame mientras se renderiza el siguiente
+        marks[STAGE_SHOW] = FrameMetrics::now();
+        ledOutput.show(output.buffer(), outputBrightness);
+        power.recordFrame(shownBrightness, now);
+        marks[STAGE_TOTAL] = FrameMetrics::now();
+        const uint32_t cpuMicros = metrics.record(blending ? FrameMetrics::TRANSITION : activeEffect, marks);
+        scheduler.recordFrameCost(cpuMicros, effect != nullptr ? effect->qualityTiers() : 1);
 
-    // Métodos para los diferentes efectos rainbow
-        void updateRainbowDiagonal() {
-        static uint8_t deltaHue = 0;
-        
-        for(uint8_t x = 0; x < LED_WIDTH; x++) {
-            uint8_t columnHue = hue + (x * 255 / LED_WIDTH);
-            
-            for(uint8_t y = 0; y < LED_HEIGHT; y++) {
-                uint8_t finalHue = columnHue + (y * 255 / LED_HEIGHT / 2);
-                uint16_t ledIndex = xy(x, y);
-                leds[ledIndex] = CHSV(finalHue, saturation, 255);
-            }
+        if (!firstFrameShown) {
+            firstFrameShown = true;
+            BootTimeline::instance().mark(BOOT_FIRST_FRAME);
         }
-        hue++;
     }
 
-    void updateRainbowHorizontal() {
-        for(uint8_t y = 0; y < LED_HEIGHT; y++) {
-            uint8_t rowHue = hue + (y * 255 / LED_HEIGHT);
-            for(uint8_t x = 0; x < LED_WIDTH; x++) {
-                leds[xy(x, y)] = CHSV(rowHue, saturation, 255);
-            }
-        }
-        hue++;
+    // Suspender los efectos mientras llega el firmware
+    void beginOtaProgress() {
+        otaProgress = 0;
+        otaShownProgress = -1;
+        otaActive = true;
     }
 
-    void updateRainbowVertical() {
-        for(uint8_t x = 0; x < LED_WIDTH; x++) {
-            uint8_t columnHue = hue + (x * 255 / LED_WIDTH);
-            for(uint8_t y = 0; y < LED_HEIGHT; y++) {
-                leds[xy(x, y)] = CHSV(columnHue, saturation, 255);
-            }
-        }
-        hue++;
+    void setOtaProgress(uint8_t percent) {
+        otaProgress = min(percent, (uint8_t)100);
     }
 
-    void updateRainbowCircular() {
-        uint8_t centerX = LED_WIDTH / 2;
-        uint8_t centerY = LED_HEIGHT / 2;
-        
-        for(uint8_t x = 0; x < LED_WIDTH; x++) {
-            for(uint8_t y = 0; y < LED_HEIGHT; y++) {
-                float distance = sqrt(pow(x - centerX, 2) + pow(y - centerY, 2));
-                uint8_t finalHue = hue + (distance * 255 / max(LED_WIDTH, LED_HEIGHT));
-                leds[xy(x, y)] = CHSV(finalHue, saturation, 255);
-            }
-        }
-        hue++;
-    }
-
-    void updateRainbow() {
-        if (rainbowType == "diagonal") {
-            updateRainbowDiagonal();
-        } else if (rainbowType == "horizontal") {
-            updateRainbowHorizontal();
-        } else if (rainbowType == "vertical") {
-            updateRainbowVertical();
-        } else if (rainbowType == "circular") {
-            updateRainbowCircular();
-        } else {
-            updateRainbowDiagonal();
+    // Si la actualización falló se reanuda el efecto que estaba activo
+    void endOtaProgress(bool success) {
+        if (success) {
+            otaProgress = 100;
+            return;
         }
+        otaActive = false;
     }
 
-    // Función para convertir coordenadas x,y a índice LED
-    uint16_t xy(uint8_t x, uint8_t y) {
-        uint16_t i;
-        if (y & 0x01) { // Filas impares
-            i = (y * LED_WIDTH) + (LED_WIDTH - 1 - x);
-        } else {        // Filas pares
-            i = (y * LED_WIDTH) + x;
-        }
-        return i;
+    bool isOtaActive() const {
+        return otaActive;
     }
 
-    uint16_t clockXY(uint8_t x, uint8_t y) {
-        // Invertir coordenadas para rotación 180°
-        //x = LED_WIDTH - 1 - x;
-        y = LED_HEIGHT - 1 - y;
-        return xy(x, y);
+    // Solicita una copia del próximo frame; el render la hace sin esperar a nadie
+    bool requestSnapshot(uint8_t* target) {
+        if (snapshotTarget != nullptr) return false;
+        snapshotReady = false;
+        snapshotTarget = target;
+        return true;
     }
 
-    // Método para inicializar el fuego
-        void initFire() {
-        const uint8_t centerStart = (uint8_t)(LED_WIDTH * 0.15);
-        const uint8_t centerEnd = (uint8_t)(LED_WIDTH * 0.85);
-        
-        for(uint8_t x = 0; x < LED_WIDTH; x++) {
-            if (x >= centerStart && x <= centerEnd) {
-                firePixels[xy(x, 0)] = PALETTE_SIZE - 1;
-            } else {
-                uint8_t distanceFromCenter = min((int)abs(x - centerStart), (int)abs(x - centerEnd));
-                uint8_t intensity = (4 - distanceFromCenter) > 0 ? (4 - distanceFromCenter) : 0;
-                firePixels[xy(x, 0)] = intensity;
-            }
-        }
+    void cancelSnapshot() {
+        snapshotTarget = nullptr;
     }
 
-    void updateFire() {
-        static uint32_t frameCount = 0;
-        if (frameCount++ % 2 != 0) return;
-        
-        for(uint8_t x = 0; x < LED_WIDTH; x++) {
-            for(uint8_t y = 1; y < LED_HEIGHT; y++) {
-                const uint8_t centerX = LED_WIDTH / 2;
-                const uint8_t distanceFromCenter = abs(x - centerX) / (LED_WIDTH / 2);
-                
-                const uint8_t decay = random(2.1);
-                int8_t drift = random(3) - 1;
-                
-                if (x < LED_WIDTH * 0.2) {
-                    drift = drift < 0 ? 0 : drift;
-                } else if (x > LED_WIDTH * 0.8) {
-                    drift = drift > 0 ? 0 : drift;
-                }
-                
-                int16_t newX = x + drift;
-                newX = constrain(newX, 0, LED_WIDTH - 1);
-                
-                uint16_t belowIndex = xy(x, y-1);
-                uint16_t targetIndex = xy(newX, y);
-                
-                int16_t value = firePixels[belowIndex];
-                if(value > decay) {
-                    value -= decay;
-                } else {
-                    value = 0;
-                }
-                
-                if (random(10) == 0 && value > 0) {
-                    value += random(3);
-                    if(value >= PALETTE_SIZE) value = PALETTE_SIZE - 1;
-                }
-                
-                firePixels[targetIndex] = value;
-            }
-        }
+    bool isSnapshotReady() const {
+        return snapshotReady;
+    }
 
-        for(uint8_t y = 0; y < LED_HEIGHT; y++) {
-            for(uint8_t x = 0; x < LED_WIDTH; x++) {
-                uint16_t index = xy(x, y);
-                uint8_t colorIndex = firePixels[index];
-                leds[index] = firePalettes[currentFirePalette][colorIndex];
-            }
-        }
+    // Los setters solo guardan el valor; el loop de render lo aplica en el
+    // siguiente frame (pueden llamarse desde la tarea de red). Brillo, tono
+    // y saturación llegan a su valor en rampa durante rampMs.
+    void setBrightness(uint8_t newBrightness, uint16_t rampMs = PARAM_RAMP_MS) {
+        brightness.set(newBrightness, rampMs);
+        changeCounter++;
     }
 
-    void updateBreathing() {
-        if (breathingUp) {
-            breathVal += 2;
-            if (breathVal >= 252) breathingUp = false;
-        } else {
-            breathVal -= 2;
-            if (breathVal <= 0) breathingUp = true;
+    // Duración del fundido entre efectos (0 = cambio inmediato)
+    void setTransitionDuration(uint16_t ms) {
+        transitionMs = min(ms, MAX_EFFECT_TRANSITION_MS);
+    }
+
+    // Solo Fuego y Arcoíris dibujan por región; el resto la ignora
+    void setSymmetry(LedEffect target, SymmetryMode mode) {
+        if (target < OFF && mode < SYMMETRY_COUNT) {
+            symmetry[target] = mode;
         }
-        
-        fill_solid(leds, NUM_LEDS, CHSV(hue, saturation, breathVal));
     }
 
-public:
-    LedManager() : 
-        currentEffect(FIRE), 
-        brightness(MAX_BRIGHTNESS), 
-        isOn(true), 
-        lastUpdate(0),
-        rainbowType("diagonal"),
-        currentFirePalette(0),
-        timeClient(ntpUDP, "pool.ntp.org", -6 * 3600)  // UTC-6 para CDMX
-    {
-        FastLED.addLeds<WS2812B, LED_PIN, GRB>(leds, NUM_LEDS);
-        FastLED.setBrightness(brightness);
-        memset(firePixels, 0, NUM_LEDS);
-        initFire();
+    SymmetryMode getSymmetry(LedEffect target) const {
+        return target < OFF ? symmetry[target] : SYMMETRY_NONE;
     }
 
-    void begin() {
-        FastLED.clear();
-        FastLED.show();
+    // Desenfoque o resplandor de un efecto (se aplica desde el siguiente frame)
+    void setPostFx(LedEffect target, PostFxMode mode, uint8_t radius, uint8_t threshold) {
+        if (target < OFF && mode < POSTFX_COUNT) {
+            postFxSettings[target] = {mode, constrain(radius, (uint8_t)1, MAX_BLUR_RADIUS), threshold};
+        }
     }
 
-    void handle() {
-        if (!isOn) {
-            FastLED.clear();
-            FastLED.show();
+    // Capa sobre el efecto base; el generador se construye en el siguiente
+    // frame y el resto de la configuración se lee en cada frame
+    void setLayer(uint8_t layer, const LayerConfig& config) {
+        if (layer >= OVERLAY_LAYERS || config.effect > OFF ||
+            config.blend >= BLEND_MODE_COUNT || config.mask >= LAYER_MASK_COUNT ||
+            config.symmetry >= SYMMETRY_COUNT || config.postFx.mode >= POSTFX_COUNT) {
             return;
         }
+        LayerConfig accepted = config;
+        accepted.postFx.radius = constrain(config.postFx.radius, (uint8_t)1, MAX_BLUR_RADIUS);
+        layers[layer] = accepted;
+    }
 
-        unsigned long currentMillis = millis();
-        if (currentMillis - lastUpdate >= 20) {
-            lastUpdate = currentMillis;
-
-            switch (currentEffect) {
-                case BREATHING:
-                    updateBreathing();
-                    break;
-                case RAINBOW:
-                    updateRainbow();
-                    break;
-                case FIRE:
-                    static bool fireInitialized = false;
-                    if (!fireInitialized) {
-                        initFire();
-                        fireInitialized = true;
-                    }
-                    updateFire();
-                    break;
-                case LIFE:
-                    static bool lifeInitialized = false;
-                    if (!lifeInitialized) {
-                        initLife();
-                        lifeInitialized = true;
-                    }
-                    updateLife();
-                    break;
-                case SOLID:
-                    fill_solid(leds, NUM_LEDS, CHSV(hue, saturation, 255));
-                    break;
-                case OFF:
-                    FastLED.clear();
-                    break;
-                case CLOCK:
-                    static bool clockInitialized = false;
-                    if (!clockInitialized) {
-                        initClock();
-                        clockInitialized = true;
-                    }
-                    updateClock();
-                    break;
-            }
-
-            FastLED.setBrightness(brightness);
-            FastLED.show();
-        }
+    LayerConfig getLayer(uint8_t layer) const {
+        return layers[layer < OVERLAY_LAYERS ? layer : 0];
     }
 
-    void setBrightness(uint8_t newBrightness) {
-    brightness = newBrightness;
-    FastLED.setBrightness(brightness);
-    FastLED.show();
-    handle();
+    PostFxSettings getPostFxSettings(LedEffect target) const {
+        return target < OFF ? postFxSettings[target] : PostFxSettings{POSTFX_NONE, BLUR_RADIUS, BLOOM_THRESHOLD};
     }
 
     void setEffect(LedEffect effect) {
         currentEffect = effect;
+        changeCounter++;
         if (effect == OFF) {
             isOn = false;
         } else {
@@ -811,71 +465,107 @@ public:
     void setState(bool state) {
         if (state == isOn) return;
         
-        isOn = state;
-        if (!isOn) {
-            FastLED.clear();
-            FastLED.show();
-            handle();
-        } else {
-            if (currentEffect == OFF) {
-                currentEffect = SOLID;
-            }
-            FastLED.setBrightness(brightness);
-            FastLED.show();
-            handle();
+        if (state && currentEffect == OFF) {
+            currentEffect = SOLID;
         }
+        isOn = state;
+        changeCounter++;
     }
 
-    void setHue(uint8_t newHue) {
-        hue = newHue;
-    }
-
-    void setSaturation(uint8_t newSaturation) {
-        saturation = newSaturation;
-    }
-
-    void setBook(uint8_t newBook) {
-        book = newBook;
+    void setHue(uint8_t newHue, uint16_t rampMs = PARAM_RAMP_MS) {
+        hue.set(newHue, rampMs);
+        changeCounter++;
     }
 
-    void setChapter(uint8_t newChapter) {
-        chapter = newChapter;
+    void setSaturation(uint8_t newSaturation, uint16_t rampMs = PARAM_RAMP_MS) {
+        saturation.set(newSaturation, rampMs);
+        changeCounter++;
     }
 
-    void setVerse(uint8_t newVerse) {
-        verse = newVerse;
+    void setPassage(uint8_t book, uint8_t chapter, uint8_t verse) {
+        passage = ((uint32_t)book << 16) | ((uint32_t)chapter << 8) | verse;
     }
 
-    void setRainbowType(String type) {
-        if (type == "diagonal" || type == "horizontal" || 
-            type == "vertical" || type == "circular") {
-            rainbowType = type;
+    void setRainbowType(const char* type) {
+        if (type == nullptr) return;
+        for (uint8_t i = 0; i < RAINBOW_TYPE_COUNT; i++) {
+            if (strcmp(type, RAINBOW_TYPES[i]) == 0) {
+                rainbowType = static_cast<RainbowType>(i);
+                changeCounter++;
+                break;
+            }
         }
     }
 
     void setFirePalette(uint8_t paletteIndex) {
-        if (paletteIndex < 6) {
+        if (paletteIndex < FireEffect::PALETTE_COUNT) {
             currentFirePalette = paletteIndex;
+            changeCounter++;
         }
     }
 
+    // El patrón se siembra en el render, al inicio del siguiente frame
     void setLifePatternFromWeb(uint8_t pattern) {
-        setLifePattern(static_cast<LifePattern>(pattern));
+        if (pattern > LifeEffect::LWSS) return;
+        currentLifePattern = pattern;
+        lifePatternRequested = true;
+        changeCounter++;
     }
 
     void setAutoRestart(bool enabled) {
         autoRestart = enabled;
+        changeCounter++;
     }
 
     void setLifeSpeed(float speed) {
         for (int i = 0; i < 6; i++) {
             if (abs(SPEED_VALUES[i] - speed) < 0.01) {
                 lifeSpeed = SPEED_VALUES[i];
+                changeCounter++;
                 break;
             }
         }
     }
 
+    // Restaurar la configuración guardada sin renderizar (antes del primer frame)
+    void applySettings(const LedSettings& settings) {
+        currentEffect = settings.effect <= OFF ? static_cast<LedEffect>(settings.effect) : FIRE;
+        brightness.jump(settings.brightness);
+        hue.jump(settings.hue);
+        saturation.jump(settings.saturation);
+        if (settings.firePalette < FireEffect::PALETTE_COUNT) {
+            currentFirePalette = settings.firePalette;
+        }
+        if (settings.rainbowType < RAINBOW_TYPE_COUNT) {
+            rainbowType = static_cast<RainbowType>(settings.rainbowType);
+        }
+        if (settings.lifePattern <= LifeEffect::LWSS) {
+            currentLifePattern = settings.lifePattern;
+        }
+        setLifeSpeed(settings.lifeSpeedQuarters / 4.0f);
+        autoRestart = settings.autoRestart;
+        isOn = settings.isOn && currentEffect != OFF;
+    }
+
+    LedSettings captureSettings() const {
+        LedSettings settings;
+        settings.effect = static_cast<uint8_t>(currentEffect);
+        settings.brightness = brightness.getTarget();
+        settings.hue = hue.getTarget();
+        settings.saturation = saturation.getTarget();
+        settings.firePalette = currentFirePalette;
+        settings.rainbowType = rainbowType;
+        settings.lifePattern = currentLifePattern;
+        settings.lifeSpeedQuarters = static_cast<uint8_t>(lifeSpeed * 4 + 0.5f);
+        settings.isOn = isOn;
+        settings.autoRestart = autoRestart;
+        return settings;
+    }
+
+    uint32_t getChangeCounter() const {
+        return changeCounter;
+    }
+
     float getLifeSpeed() const {
         return lifeSpeed;
     }
@@ -885,15 +575,15 @@ public:
     }
 
     uint8_t getCurrentLifePattern() const {
-        return static_cast<uint8_t>(currentLifePattern);
+        return currentLifePattern;
     }
 
     uint8_t getFirePalette() const {
         return currentFirePalette;
     }
 
-    String getRainbowType() const {
-        return rainbowType;
+    const char* getRainbowType() const {
+        return RAINBOW_TYPES[rainbowType];
     }
 
     bool getState() const {
@@ -901,20 +591,111 @@ public:
     }
 
     uint8_t getBrightness() const {
-        return brightness;
+        return brightness.getTarget();
     }
 
     uint8_t getHue() const {
-        return hue;
+        return hue.getTarget();
     }
 
     uint8_t getSaturation() const {
-        return saturation;
+        return saturation.getTarget();
     }
 
     LedEffect getCurrentEffect() const {
         return currentEffect;
     }
+
+    uint16_t getTransitionDuration() const {
+        return transitionMs;
+    }
+
+    const FrameMetrics& getMetrics() const {
+        return metrics;
+    }
+
+    const FrameScheduler& getScheduler() const {
+        return scheduler;
+    }
+
+    // Salida de 16 bits con dithering (se puede cambiar en caliente)
+    void setHighDepthOutput(bool enable) {
+        output.setEnabled(enable);
+    }
+
+    bool isHighDepthOutput() const {
+        return output.isEnabled();
+    }
+
+    const PowerLimiter& getPower() const {
+        return power;
+    }
+
+    const PostFx& getPostFx() const {
+        return postFx;
+    }
+
+    // Sus setters solo guardan valores, así que la API puede usarlos directo
+    TextOverlay& getOverlay() {
+        return overlay;
+    }
+
+    QualityTier getQuality() const {
+        return scheduler.getQuality();
+    }
+
+    // El reinicio se aplica en el siguiente frame
+    void resetMetrics() {
+        metrics.requestReset();
+        scheduler.requestReset();
+        power.requestReset();
+        postFx.requestReset();
+    }
+
+    // Bytes de arena que ocupa el efecto activo
+    uint16_t getEffectMemory() const {
+        return arenas[activeSlot].getActiveBytes();
+    }
+
+    // Memoria fija del render por bloque; "other" es el resto de LedManager
+    struct MemoryBlock {
+        const char* name;
+        uint32_t bytes;
+    };
+    static const uint8_t MEMORY_BLOCK_COUNT = 9;
+
+    static MemoryBlock memoryBlock(uint8_t index) {
+        const MemoryBlock blocks[MEMORY_BLOCK_COUNT - 1] = {
+            {"frame", sizeof(leds)},
+            {"transitionFrame", sizeof(transitionFrame)},
+            {"layerFrame", sizeof(layerFrame)},
+            {"output", sizeof(output)},
+            {"postFx", sizeof(postFx)},
+            {"effectArenas", sizeof(arenas)},
+            {"overlay", sizeof(overlay)},
+            {"metrics", sizeof(metrics)}
+        };
+        if (index < MEMORY_BLOCK_COUNT - 1) return blocks[index];
+
+        uint32_t listed = 0;
+        for (const MemoryBlock& block : blocks) listed += block.bytes;
+        return {"other", (uint32_t)sizeof(LedManager) - listed};
+    }
+
+    static void printMemoryReport() {
+        Serial.printf("Memoria del render: %u bytes (presupuesto %u)\n",
+                      (unsigned)sizeof(LedManager), (unsigned)RENDER_MEMORY_BUDGET);
+        for (uint8_t i = 0; i < MEMORY_BLOCK_COUNT; i++) {
+            const MemoryBlock block = memoryBlock(i);
+            Serial.printf("  %-16s %5u bytes\n", block.name, (unsigned)block.bytes);
+        }
+        EffectArena::printReport();
+    }
 };
 
+// Frames, arenas y capas se reservan una sola vez; el presupuesto cubre
+// todo lo que el render agregó sobre leds[]
+static_assert(sizeof(LedManager) <= RENDER_MEMORY_BUDGET,
+              "LedManager excede RENDER_MEMORY_BUDGET; reducir sus buffers o subir el presupuesto");
+
 #endif
\ No newline at end of file
@@ -0,0 +1,61 @@
+#ifndef LED_OUTPUT_H
+#define LED_OUTPUT_H
+
+#include <FastLED.h>
+#include "config.h"
+
+// Envío de frames a los LEDs en su propia tarea. FastLED.show() ocupa el
+// cable LED_WIRE_US (casi todo el intervalo) esperando al periférico, no al
+// CPU; en esta tarea esa espera corre en paralelo con el render del frame
+// siguiente. El render convierte cada frame en el buffer libre de
+// OutputPipeline y lo entrega aquí: show() solo espera a que la tarea tome
+// el frame, lo que ocurre en cuanto termina de enviar el anterior.
+class LedOutput {
+private:
+    TaskHandle_t taskHandle;
+    SemaphoreHandle_t taken;  // La tarea ya tomó el frame entregado
+
+    CRGB* volatile pendingFrame;
+    volatile uint8_t pendingBrightness;
+
+    void run() {
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            FastLED[0].setLeds(pendingFrame, NUM_LEDS);
+            FastLED.setBrightness(pendingBrightness);
+
+            // El otro buffer ya no está en el cable: el render puede escribirlo
+            xSemaphoreGive(taken);
+            FastLED.show();
+        }
+    }
+
+    static void taskEntry(void* param) {
+        static_cast<LedOutput*>(param)->run();
+    }
+
+public:
+    LedOutput()
+        : taskHandle(nullptr),
+          taken(nullptr),
+          pendingFrame(nullptr),
+          pendingBrightness(0) {}
+
+    void begin() {
+        taken = xSemaphoreCreateBinary();
+        xTaskCreatePinnedToCore(taskEntry, "output", LED_OUTPUT_TASK_STACK, this,
+                                LED_OUTPUT_TASK_PRIORITY, &taskHandle, LED_OUTPUT_TASK_CORE);
+    }
+
+    // Entregar un frame ya convertido con el brillo que debe usar FastLED.
+    // Regresa cuando la tarea lo tomó; frame no se puede escribir hasta
+    // que se entregue el siguiente
+    void show(CRGB* frame, uint8_t brightness) {
+        pendingFrame = frame;
+        pendingBrightness = brightness;
+        xTaskNotifyGive(taskHandle);
+        xSemaphoreTake(taken, portMAX_DELAY);
+    }
+};
+
+#endif
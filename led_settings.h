@@ -0,0 +1,20 @@
+#ifndef LED_SETTINGS_H
+#define LED_SETTINGS_H
+
+#include <Arduino.h>
+
+// Estado persistente del LedManager (ver settings_store.h)
+struct LedSettings {
+    uint8_t effect;
+    uint8_t brightness;
+    uint8_t hue;
+    uint8_t saturation;
+    uint8_t firePalette;
+    uint8_t rainbowType;        // Índice en RAINBOW_TYPES
+    uint8_t lifePattern;
+    uint8_t lifeSpeedQuarters;  // lifeSpeed * 4
+    bool isOn;
+    bool autoRestart;
+};
+
+#endif
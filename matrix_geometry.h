@@ -0,0 +1,58 @@
+#ifndef MATRIX_GEOMETRY_H
+#define MATRIX_GEOMETRY_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Geometría de la matriz (cableado en serpentina, y = 0 es la fila inferior)
+namespace Matrix {
+    const uint8_t WIDTH = 27;
+    const uint8_t HEIGHT = 26;
+
+    static_assert(WIDTH * HEIGHT == NUM_LEDS, "La matriz no coincide con NUM_LEDS");
+
+    // En modo anillo las columnas dan la vuelta al fogón: no hay bordes
+    // laterales y la última columna es vecina de la primera
+    const bool RING = MATRIX_IS_RING;
+
+    // Ángulo de cada columna alrededor del fogón (0-255, sin costura)
+    constexpr uint8_t ANGLE[WIDTH] = {
+        0, 9, 18, 28, 37, 47, 56, 66, 75, 85, 94, 104, 113, 123,
+        132, 142, 151, 161, 170, 180, 189, 199, 208, 218, 227, 237, 246
+    };
+
+    // Altura de cada fila (0 = base, 255 = fila superior)
+    constexpr uint8_t HEIGHT_LEVEL[HEIGHT] = {
+        0, 10, 20, 30, 40, 51, 61, 71, 81, 91, 102, 112, 122,
+        132, 142, 153, 163, 173, 183, 193, 204, 214, 224, 234, 244, 255
+    };
+
+    // Columnas vecinas sin módulo; en modo plano se quedan en el borde
+    inline uint8_t leftOf(uint8_t x) {
+        return x > 0 ? x - 1 : (RING ? WIDTH - 1 : 0);
+    }
+
+    inline uint8_t rightOf(uint8_t x) {
+        return x + 1 < WIDTH ? x + 1 : (RING ? 0 : WIDTH - 1);
+    }
+
+    // Columna desplazada una posición (dx = -1, 0 o 1)
+    inline uint8_t shiftX(uint8_t x, int8_t dx) {
+        return dx < 0 ? leftOf(x) : (dx > 0 ? rightOf(x) : x);
+    }
+
+    // Función para convertir coordenadas x,y a índice LED
+    inline uint16_t xy(uint8_t x, uint8_t y) {
+        if (y & 0x01) { // Filas impares
+            return (y * WIDTH) + (WIDTH - 1 - x);
+        }
+        return (y * WIDTH) + x;  // Filas pares
+    }
+
+    // Coordenadas del reloj: y = 0 es la fila superior
+    inline uint16_t clockXY(uint8_t x, uint8_t y) {
+        return xy(x, HEIGHT - 1 - y);
+    }
+}
+
+#endif
@@ -0,0 +1,273 @@
+#ifndef NETWORK_TASK_H
+#define NETWORK_TASK_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Rueda de temporizadores periódicos. Cada temporizador vive en la ranura
+// donde vence; avanzar la rueda solo revisa la ranura actual, en lugar de
+// comparar millis() contra cada tarea en cada vuelta.
+class TimerWheel {
+public:
+    typedef std::function<void()> Callback;
+
+    static const uint8_t SLOTS = 32;
+    static const uint8_t MAX_TIMERS = 8;
+
+private:
+    struct Timer {
+        uint32_t intervalTicks;
+        uint32_t rounds;      // Vueltas completas que faltan antes de vencer
+        int8_t next;          // Siguiente temporizador en la misma ranura
+        Callback callback;
+    };
+
+    Timer timers[MAX_TIMERS];
+    int8_t slots[SLOTS];
+    uint8_t timerCount;
+    uint8_t currentSlot;
+    uint16_t tickMillis;
+    unsigned long lastTick;
+
+    void schedule(int8_t id) {
+        Timer& timer = timers[id];
+        const uint32_t ticks = max(timer.intervalTicks, (uint32_t)1);
+        const uint8_t slot = (currentSlot + ticks) % SLOTS;
+        timer.rounds = (ticks - 1) / SLOTS;
+        timer.next = slots[slot];
+        slots[slot] = id;
+    }
+
+public:
+    TimerWheel(uint16_t tickMs)
+        : timerCount(0), currentSlot(0), tickMillis(tickMs), lastTick(0) {
+        for (uint8_t i = 0; i < SLOTS; i++) {
+            slots[i] = -1;
+        }
+    }
+
+    void begin(unsigned long now) {
+        lastTick = now;
+    }
+
+    // Devuelve el id del temporizador o -1 si la rueda está llena
+    int8_t every(unsigned long intervalMs, Callback callback) {
+        if (timerCount >= MAX_TIMERS) return -1;
+        const int8_t id = timerCount++;
+        timers[id].intervalTicks = (intervalMs + tickMillis - 1) / tickMillis;
+        timers[id].callback = callback;
+        schedule(id);
+        return id;
+    }
+
+    void advance(unsigned long now) {
+        while (now - lastTick >= tickMillis) {
+            lastTick += tickMillis;
+            currentSlot = (currentSlot + 1) % SLOTS;
+
+            // Separar la lista de la ranura; lo que no vence se vuelve a insertar
+            int8_t id = slots[currentSlot];
+            slots[currentSlot] = -1;
+            while (id >= 0) {
+                const int8_t next = timers[id].next;
+                if (timers[id].rounds > 0) {
+                    timers[id].rounds--;
+                    timers[id].next = slots[currentSlot];
+                    slots[currentSlot] = id;
+                } else {
+                    timers[id].callback();
+                    schedule(id);
+                }
+                id = next;
+            }
+        }
+    }
+
+    unsigned long millisUntilNextTick(unsigned long now) const {
+        const unsigned long elapsed = now - lastTick;
+        return elapsed >= tickMillis ? 0 : tickMillis - elapsed;
+    }
+};
+
+// Tarea de red en el núcleo 0. Duerme hasta que llega un evento (WiFi) o
+// vence el intervalo de sondeo, atiende los servicios registrados y corre
+// las tareas periódicas desde la rueda de temporizadores. Mide el tiempo de
+// CPU de cada servicio para que el costo en reposo sea visible.
+class NetworkTask {
+public:
+    typedef std::function<void()> Service;
+
+    static const uint8_t MAX_SERVICES = 10;
+
+    struct ServiceStats {
+        const char* name;
+        uint32_t runs;
+        uint32_t busyMicros;       // Acumulado de la ventana actual
+        uint16_t loadPermille;     // Carga de la última ventana (0-1000)
+        uint32_t maxMicros;        // Ejecución más larga de la última ventana
+    };
+
+private:
+    struct ServiceSlot {
+        Service service;
+        ServiceStats stats;
+        uint32_t windowMaxMicros;
+    };
+
+    ServiceSlot services[MAX_SERVICES];
+    uint8_t serviceCount;
+    uint8_t polledCount;
+    TimerWheel wheel;
+    TaskHandle_t taskHandle;
+
+    unsigned long windowStart;
+    uint32_t wakeups;
+    uint32_t wakeupsPerSecond;
+    uint16_t busyPermille;
+
+    void run(uint8_t index) {
+        ServiceSlot& slot = services[index];
+        const unsigned long start = micros();
+        slot.service();
+        const uint32_t elapsed = micros() - start;
+        slot.stats.busyMicros += elapsed;
+        slot.stats.runs++;
+        if (elapsed > slot.windowMaxMicros) {
+            slot.windowMaxMicros = elapsed;
+        }
+    }
+
+    int8_t addSlot(const char* name, Service service) {
+        if (serviceCount >= MAX_SERVICES) return -1;
+        ServiceSlot& slot = services[serviceCount];
+        slot.service = service;
+        slot.stats.name = name;
+        slot.stats.runs = 0;
+        slot.stats.busyMicros = 0;
+        slot.stats.loadPermille = 0;
+        slot.stats.maxMicros = 0;
+        slot.windowMaxMicros = 0;
+        return serviceCount++;
+    }
+
+    // Cerrar la ventana de medición y calcular la carga de cada servicio
+    void closeStatsWindow() {
+        const unsigned long now = micros();
+        const uint32_t window = max((uint32_t)(now - windowStart), (uint32_t)1);
+        uint32_t totalBusy = 0;
+
+        for (uint8_t i = 0; i < serviceCount; i++) {
+            ServiceStats& stats = services[i].stats;
+            stats.loadPermille = (uint64_t)stats.busyMicros * 1000 / window;
+            stats.maxMicros = services[i].windowMaxMicros;
+            totalBusy += stats.busyMicros;
+            stats.busyMicros = 0;
+            services[i].windowMaxMicros = 0;
+        }
+
+        busyPermille = (uint64_t)totalBusy * 1000 / window;
+        wakeupsPerSecond = (uint64_t)wakeups * 1000000 / window;
+        wakeups = 0;
+        windowStart = now;
+    }
+
+public:
+    void printStats() {
+        Serial.printf("[red] despertares/s: %u, carga total: %u.%u%%\n",
+                      wakeupsPerSecond, busyPermille / 10, busyPermille % 10);
+        for (uint8_t i = 0; i < serviceCount; i++) {
+            const ServiceStats& stats = services[i].stats;
+            Serial.printf("  %-10s %3u.%u%%  max %lu us\n", stats.name,
+                          stats.loadPermille / 10, stats.loadPermille % 10,
+                          (unsigned long)stats.maxMicros);
+        }
+    }
+
+private:
+    void loop() {
+        wheel.begin(millis());
+        windowStart = micros();
+
+        for (;;) {
+            const unsigned long now = millis();
+            const unsigned long timeout = min(NETWORK_POLL_INTERVAL, wheel.millisUntilNextTick(now));
+
+            // Un evento WiFi despierta la tarea antes del tiempo límite
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(max(timeout, (unsigned long)1)));
+            wakeups++;
+
+            for (uint8_t i = 0; i < polledCount; i++) {
+                run(i);
+            }
+            wheel.advance(millis());
+        }
+    }
+
+    static void taskEntry(void* param) {
+        static_cast<NetworkTask*>(param)->loop();
+    }
+
+public:
+    NetworkTask()
+        : serviceCount(0),
+          polledCount(0),
+          wheel(TIMER_WHEEL_TICK),
+          taskHandle(nullptr),
+          windowStart(0),
+          wakeups(0),
+          wakeupsPerSecond(0),
+          busyPermille(0) {}
+
+    // Servicio que se atiende en cada despertar (sondeo de sockets)
+    // Deben registrarse antes que los periódicos.
+    bool poll(const char* name, Service service) {
+        if (polledCount != serviceCount) return false;
+        if (addSlot(name, service) < 0) return false;
+        polledCount++;
+        return true;
+    }
+
+    // Servicio periódico atendido desde la rueda de temporizadores
+    bool every(const char* name, unsigned long intervalMs, Service service) {
+        const int8_t index = addSlot(name, service);
+        if (index < 0) return false;
+        return wheel.every(intervalMs, [this, index]() { run(index); }) >= 0;
+    }
+
+    void begin() {
+        every("stats", NETWORK_STATS_INTERVAL, [this]() {
+            closeStatsWindow();
+        });
+        xTaskCreatePinnedToCore(taskEntry, "network", NETWORK_TASK_STACK, this, 1,
+                                &taskHandle, NETWORK_TASK_CORE);
+    }
+
+    // Despertar la tarea (se puede llamar desde callbacks de eventos)
+    void notify() {
+        if (taskHandle != nullptr) {
+            xTaskNotifyGive(taskHandle);
+        }
+    }
+
+    TaskHandle_t getTaskHandle() const {
+        return taskHandle;
+    }
+
+    uint8_t getServiceCount() const {
+        return serviceCount;
+    }
+
+    const ServiceStats& getServiceStats(uint8_t index) const {
+        return services[index].stats;
+    }
+
+    uint32_t getWakeupsPerSecond() const {
+        return wakeupsPerSecond;
+    }
+
+    uint16_t getBusyPermille() const {
+        return busyPermille;
+    }
+};
+
+#endif
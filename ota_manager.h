@@ -6,32 +6,72 @@
 #include <WiFiUdp.h>
 #include <ArduinoOTA.h>
 #include "config.h"
+#include "boot_timeline.h"
+#include "led_manager.h"
+#include "wifi_reconnect.h"
 
 class OTAManager {
 private:
+    LedManager* ledManager;
     DeviceState currentState;
-    unsigned long previousWifiCheck;
-    unsigned long lastInfoPrint;
+    unsigned long lastProgressPrint;
     bool isWiFiConnected;
+    bool otaReady;
+    std::function<void()> firstConnectionCallback;
+    std::function<void()> eventCallback;
+    std::function<void()> beforeRestartCallback;
+
+    // Eventos WiFi (llegan desde la tarea de eventos del sistema)
+    volatile bool wifiGotIp;
+    volatile bool wifiLost;
+
+    // Reconexión con espera exponencial (ver wifi_reconnect.h)
+    WifiReconnect reconnect;
+
+    // Medición de la última actualización
+    unsigned long otaStartMillis;
+    unsigned long lastOtaDuration;
+    uint32_t lastOtaBytes;
+    int lastOtaPercent;
 
     void setupOTA() {
         ArduinoOTA.setPort(OTA_PORT);
         ArduinoOTA.setHostname(OTA_HOSTNAME);
         ArduinoOTA.setPassword(OTA_PASSWORD);
 
-        ArduinoOTA.onStart([]() {
+        ArduinoOTA.onStart([this]() {
             Serial.println(SystemMessages::OTA_START);
+            currentState = UPDATING_OTA;
+            otaStartMillis = millis();
+            lastOtaBytes = 0;
+            lastOtaPercent = -1;
+            ledManager->beginOtaProgress();
         });
         
-        ArduinoOTA.onEnd([]() {
+        ArduinoOTA.onEnd([this]() {
+            lastOtaDuration = millis() - otaStartMillis;
             Serial.println(SystemMessages::OTA_COMPLETE);
+            Serial.printf(SystemInfo::OTA_STATS_FORMAT, lastOtaBytes, lastOtaDuration,
+                          lastOtaDuration > 0 ? lastOtaBytes / lastOtaDuration : 0);
+            ledManager->endOtaProgress(true);
+
+            // ArduinoOTA reinicia en cuanto esto regresa
+            if (beforeRestartCallback) beforeRestartCallback();
         });
         
-        ArduinoOTA.onProgress([](unsigned int progress, unsigned int total) {
-            Serial.printf("Progreso: %u%%\r", (progress / (total / 100)));
+        // El loop de render pinta la barra; aquí solo se publica el porcentaje
+        ArduinoOTA.onProgress([this](unsigned int progress, unsigned int total) {
+            lastOtaBytes = progress;
+            const int percent = total > 0 ? (uint64_t)progress * 100 / total : 0;
+            if (percent == lastOtaPercent) return;
+            lastOtaPercent = percent;
+            Serial.printf("Progreso: %u%%\r", percent);
+            ledManager->setOtaProgress(percent);
         });
         
-        ArduinoOTA.onError([](ota_error_t error) {
+        ArduinoOTA.onError([this](ota_error_t error) {
+            currentState = RUNNING;
+            ledManager->endOtaProgress(false);
             Serial.printf("Error[%u]: ", error);
             switch (error) {
                 case OTA_AUTH_ERROR: Serial.println(SystemMessages::OTA_AUTH_ERROR); break;
@@ -44,35 +84,65 @@ private:
         });
 
         ArduinoOTA.begin();
+        otaReady = true;
         Serial.println(SystemMessages::OTA_INITIALIZED);
+        BootTimeline::instance().mark(BOOT_OTA_READY);
     }
 
-    void checkWiFiConnection() {
-        if (WiFi.status() != WL_CONNECTED) {
-            if (isWiFiConnected) {
-                Serial.println(SystemMessages::WIFI_LOST);
-                isWiFiConnected = false;
-            }
-            
+    // La conexión quedó lista (primera vez o reconexión)
+    void onConnected(unsigned long currentMillis) {
+        if (currentState == RUNNING) return;
+
+        Serial.println();
+        if (reconnect.onConnected(currentMillis)) {
+            Serial.println(SystemMessages::WIFI_RECONNECTED);
+            Serial.printf(SystemInfo::OUTAGE_FORMAT, reconnect.getLastOutageDuration(),
+                          reconnect.getReconnectAttempts());
+        } else {
+            Serial.println(SystemMessages::WIFI_CONNECTED);
+        }
+
+        isWiFiConnected = true;
+        Serial.printf(SystemInfo::IP_FORMAT, WiFi.localIP().toString().c_str());
+        BootTimeline::instance().mark(BOOT_WIFI_CONNECTED);
+
+        if (!otaReady) {
+            setupOTA();
+        }
+        currentState = RUNNING;
+
+        // Servicios que dependen de la red (web, Alexa) se levantan una sola vez
+        if (firstConnectionCallback) {
+            printSystemInfo();
+            firstConnectionCallback();
+            firstConnectionCallback = nullptr;
+        }
+    }
+
+    void onDisconnected(unsigned long currentMillis) {
+        if (currentState != RUNNING) return;
+
+        Serial.println(SystemMessages::WIFI_LOST);
+        isWiFiConnected = false;
+        currentState = CONNECTING_WIFI;
+        reconnect.onDisconnected(currentMillis);
+    }
+
+    // Reintentos con espera exponencial; nunca bloquea el loop
+    void handleConnecting(unsigned long currentMillis) {
+        if (reconnect.retryDue(currentMillis)) {
             Serial.println(SystemMessages::WIFI_RECONNECTING);
+            WiFi.disconnect();
             WiFi.begin(ssid, password);
-            
-            int retries = 0;
-            while (WiFi.status() != WL_CONNECTED && retries < MAX_WIFI_RETRIES) {
-                delay(WIFI_RETRY_DELAY);
-                retries++;
-                Serial.print(".");
-            }
-            Serial.println();
-            
-            if (WiFi.status() == WL_CONNECTED) {
-                Serial.println(SystemMessages::WIFI_RECONNECTED);
-                Serial.printf(SystemInfo::IP_FORMAT, WiFi.localIP().toString().c_str());
-                isWiFiConnected = true;
-            }
+        }
+
+        if (currentMillis - lastProgressPrint >= 500) {
+            lastProgressPrint = currentMillis;
+            Serial.print(".");
         }
     }
 
+public:
     void printSystemInfo() {
         Serial.println(SystemInfo::HEADER);
         Serial.printf(SystemInfo::STATE_FORMAT, currentState);
@@ -82,63 +152,130 @@ private:
         Serial.printf(SystemInfo::MAC_FORMAT, WiFi.macAddress().c_str());
         Serial.printf(SystemInfo::RSSI_FORMAT, WiFi.RSSI());
         Serial.printf(SystemInfo::UPTIME_FORMAT, millis() / 1000);
+        Serial.printf(SystemInfo::RECONNECT_FORMAT, reconnect.getReconnections(),
+                      reconnect.getReconnectAttempts());
+        Serial.printf(SystemInfo::OUTAGE_TOTAL_FORMAT, reconnect.getTotalOutageDuration(),
+                      reconnect.getLongestOutageDuration());
         Serial.println(SystemInfo::FOOTER);
     }
 
-public:
-    OTAManager() : currentState(INITIALIZING), previousWifiCheck(0), lastInfoPrint(0), isWiFiConnected(false) {}
+    OTAManager(LedManager* ledMgr)
+        : ledManager(ledMgr),
+          currentState(INITIALIZING),
+          lastProgressPrint(0),
+          isWiFiConnected(false),
+          otaReady(false),
+          wifiGotIp(false),
+          wifiLost(false),
+          otaStartMillis(0),
+          lastOtaDuration(0),
+          lastOtaBytes(0),
+          lastOtaPercent(-1) {}
+
+    // Se llama una vez, cuando la primera conexión WiFi está lista
+    void onFirstConnection(std::function<void()> callback) {
+        firstConnectionCallback = callback;
+    }
+
+    // Se llama desde los eventos WiFi para despertar a quien atiende handle()
+    void onWiFiEvent(std::function<void()> callback) {
+        eventCallback = callback;
+    }
 
+    // Se llama justo antes de cada reinicio (OTA terminada o error)
+    void onBeforeRestart(std::function<void()> callback) {
+        beforeRestartCallback = callback;
+    }
+
+    // Inicia la conexión y regresa de inmediato; handle() la completa
     void begin() {
-        Serial.begin(SERIAL_BAUD_RATE);
         Serial.println(SystemMessages::STARTING);
         
-        // Configuración WiFi
+        // Los eventos solo levantan banderas; handle() hace el trabajo
+        WiFi.onEvent([this](WiFiEvent_t event, WiFiEventInfo_t info) {
+            wifiGotIp = true;
+            if (eventCallback) eventCallback();
+        }, ARDUINO_EVENT_WIFI_STA_GOT_IP);
+        WiFi.onEvent([this](WiFiEvent_t event, WiFiEventInfo_t info) {
+            wifiLost = true;
+            if (eventCallback) eventCallback();
+        }, ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+
+        // Configuración WiFi (la reconexión la controla esta clase)
         currentState = CONNECTING_WIFI;
         WiFi.mode(WIFI_STA);
+        WiFi.setAutoReconnect(false);
         WiFi.begin(ssid, password);
-        
+        reconnect.begin(millis());
         Serial.println(SystemMessages::WIFI_CONNECTING);
-        while (WiFi.status() != WL_CONNECTED) {
-            delay(500);
-            Serial.print(".");
-        }
-        Serial.println();
-        
-        if (WiFi.status() == WL_CONNECTED) {
-            isWiFiConnected = true;
-            Serial.println(SystemMessages::WIFI_CONNECTED);
-            Serial.printf(SystemInfo::IP_FORMAT, WiFi.localIP().toString().c_str());
-        }
-        
-        setupOTA();
-        currentState = RUNNING;
-        printSystemInfo();
     }
 
     void handle() {
-        ArduinoOTA.handle();
-        
         unsigned long currentMillis = millis();
-        
-        // Verificar conexión WiFi
-        if (currentMillis - previousWifiCheck >= WIFI_CHECK_INTERVAL) {
-            previousWifiCheck = currentMillis;
-            checkWiFiConnection();
+
+        if (wifiLost) {
+            wifiLost = false;
+            onDisconnected(currentMillis);
         }
-        
-        // Imprimir información del sistema
-        if (currentMillis - lastInfoPrint >= SYSTEM_INFO_INTERVAL) {
-            lastInfoPrint = currentMillis;
-            printSystemInfo();
+        if (wifiGotIp) {
+            wifiGotIp = false;
+            onConnected(currentMillis);
         }
+
+        if (currentState == CONNECTING_WIFI) {
+            handleConnecting(currentMillis);
+            return;
+        }
+
+        ArduinoOTA.handle();
         
         // Manejar errores
         if (currentState == ERROR) {
             Serial.println(SystemMessages::ERROR_RECOVERY);
             delay(ERROR_RETRY_DELAY);
+            if (beforeRestartCallback) beforeRestartCallback();
             ESP.restart();
         }
     }
+
+    // Verificación periódica de respaldo por si se perdió un evento
+    void checkWiFi() {
+        if (currentState == RUNNING && WiFi.status() != WL_CONNECTED) {
+            onDisconnected(millis());
+        }
+    }
+
+    DeviceState getState() const {
+        return currentState;
+    }
+
+    uint32_t getReconnectAttempts() const {
+        return reconnect.getReconnectAttempts();
+    }
+
+    uint32_t getReconnections() const {
+        return reconnect.getReconnections();
+    }
+
+    unsigned long getLastOutageDuration() const {
+        return reconnect.getLastOutageDuration();
+    }
+
+    unsigned long getLongestOutageDuration() const {
+        return reconnect.getLongestOutageDuration();
+    }
+
+    unsigned long getTotalOutageDuration() const {
+        return reconnect.getTotalOutageDuration();
+    }
+
+    unsigned long getLastOtaDuration() const {
+        return lastOtaDuration;
+    }
+
+    uint32_t getLastOtaBytes() const {
+        return lastOtaBytes;
+    }
 };
 
 #endif
\ No newline at end of file
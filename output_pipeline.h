@@ -0,0 +1,145 @@
+#ifndef OUTPUT_PIPELINE_H
+#define OUTPUT_PIPELINE_H
+
+#include <FastLED.h>
+#include "config.h"
+
+// Paso final de leds[] al buffer que envía FastLED. Con la salida de alta
+// profundidad activa, la gamma y el brillo se aplican juntos con una tabla
+// de 16 bits (8.8) y el resultado se cuantiza a 8 bits con dithering
+// temporal ordenado: cada canal suma un umbral que rota de frame en frame,
+// así los niveles intermedios se promedian en el tiempo en lugar de caer
+// todos al mismo escalón. Desactivada, se copia el frame y el brillo lo
+// aplica FastLED como antes. En la misma pasada se suman los canales del
+// frame de entrada para el modelo de consumo (ver power_limiter.h), así el
+// frame se recorre una sola vez. Hay dos buffers de salida: mientras uno
+// está en el cable (ver led_output.h) el siguiente frame se convierte en
+// el otro.
+class OutputPipeline {
+private:
+    // Umbrales de 16 posiciones en orden de bits invertidos (0..15 * 16 + 8)
+    static constexpr uint8_t DITHER_SEQUENCE[16] = {
+        8, 136, 72, 200, 40, 168, 104, 232, 24, 152, 88, 216, 56, 184, 120, 248
+    };
+
+    alignas(4) CRGB output[2][NUM_LEDS];
+    uint8_t latest;          // Buffer del último frame convertido
+    uint16_t gamma[256];     // Nivel lineal 8.8 de cada valor, máximo 0xFF00
+    uint16_t lut[256];       // gamma * brillo
+    int16_t lutBrightness;   // Brillo con el que se armó lut (-1 = ninguno)
+    uint8_t frame;
+    volatile bool enabled;
+    uint32_t sums[3];        // Suma de cada canal del último frame convertido
+
+    void buildLut(uint8_t brightness) {
+        for (uint16_t i = 0; i < 256; i++) {
+            lut[i] = (uint32_t)gamma[i] * brightness / 255;
+        }
+        lutBrightness = brightness;
+    }
+
+    // Dos canales contiguos en una palabra: cada carril de 16 bits lleva
+    // nivel + umbral, que no pasa de 0xFFFF porque la tabla llega como
+    // máximo a 0xFF00
+    void quantizePair(const uint8_t* in, uint8_t* out, uint16_t i, uint32_t threshold) const {
+        const uint32_t levels = lut[in[i]] | ((uint32_t)lut[in[i + 1]] << 16);
+        const uint32_t quantized = ((levels + threshold) >> 8) & 0x00FF00FF;
+        out[i] = quantized;
+        out[i + 1] = quantized >> 16;
+    }
+
+public:
+    OutputPipeline() : latest(0), lutBrightness(-1), frame(0), enabled(HIGH_DEPTH_OUTPUT) {
+        fill_solid(output[0], NUM_LEDS, CRGB::Black);
+        fill_solid(output[1], NUM_LEDS, CRGB::Black);
+        memset(sums, 0, sizeof(sums));
+    }
+
+    void begin() {
+        for (uint16_t i = 0; i < 256; i++) {
+            gamma[i] = (uint16_t)(powf(i / 255.0f, OUTPUT_GAMMA) * 0xFF00 + 0.5f);
+        }
+        lutBrightness = -1;
+    }
+
+    // El último frame convertido, listo para enviar
+    CRGB* buffer() {
+        return output[latest];
+    }
+
+    void setEnabled(bool enable) {
+        enabled = enable;
+    }
+
+    bool isEnabled() const {
+        return enabled;
+    }
+
+    // Convertir el frame en el buffer que no se envió por última vez;
+    // devuelve el brillo que debe usar FastLED
+    uint8_t convert(const CRGB* source, uint8_t brightness) {
+        uint32_t red = 0, green = 0, blue = 0;
+        latest ^= 1;
+        CRGB* target = output[latest];
+
+        if (!enabled) {
+            for (uint16_t i = 0; i < NUM_LEDS; i++) {
+                target[i] = source[i];
+                red += source[i].r;
+                green += source[i].g;
+                blue += source[i].b;
+            }
+            sums[0] = red;
+            sums[1] = green;
+            sums[2] = blue;
+            return brightness;
+        }
+
+        if (brightness != lutBrightness) {
+            buildLut(brightness);
+        }
+
+        const uint8_t phase = frame++;
+        uint32_t thresholds[8];
+        for (uint8_t pair = 0; pair < 8; pair++) {
+            const uint8_t index = pair * 2 + phase;
+            thresholds[pair] = DITHER_SEQUENCE[index & 15] | ((uint32_t)DITHER_SEQUENCE[(index + 1) & 15] << 16);
+        }
+
+        // Dos pixeles por vuelta (tres pares: rg, br, gb), sumando cada canal
+        const uint8_t* in = reinterpret_cast<const uint8_t*>(source);
+        uint8_t* out = reinterpret_cast<uint8_t*>(target);
+        const uint16_t bytes = NUM_LEDS * sizeof(CRGB);
+        uint16_t i = 0;
+        for (; i + 6 <= bytes; i += 6) {
+            red += in[i] + in[i + 3];
+            green += in[i + 1] + in[i + 4];
+            blue += in[i + 2] + in[i + 5];
+            const uint8_t pair = i >> 1;
+            quantizePair(in, out, i, thresholds[pair & 7]);
+            quantizePair(in, out, i + 2, thresholds[(pair + 1) & 7]);
+            quantizePair(in, out, i + 4, thresholds[(pair + 2) & 7]);
+        }
+        // Con NUM_LEDS impar queda un pixel
+        if (i < bytes) {
+            red += in[i];
+            green += in[i + 1];
+            blue += in[i + 2];
+            quantizePair(in, out, i, thresholds[(i >> 1) & 7]);
+            out[i + 2] = (lut[in[i + 2]] + DITHER_SEQUENCE[(i + 2 + phase) & 15]) >> 8;
+        }
+        sums[0] = red;
+        sums[1] = green;
+        sums[2] = blue;
+        return 255;
+    }
+
+    // Suma de cada canal del último frame convertido, antes de gamma y brillo
+    void getChannelSums(uint32_t& red, uint32_t& green, uint32_t& blue) const {
+        red = sums[0];
+        green = sums[1];
+        blue = sums[2];
+    }
+};
+
+#endif
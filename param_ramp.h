@@ -0,0 +1,90 @@
+#ifndef PARAM_RAMP_H
+#define PARAM_RAMP_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Parámetro de 8 bits que el render lleva hacia su objetivo en rampa lineal.
+// El valor se guarda en punto fijo 8.8; al recibir un objetivo se calcula
+// el incremento por frame una sola vez y cada frame cuesta una suma, una
+// resta y una comparación. set() puede llamarse desde otra tarea: solo deja
+// el pedido, que advance() aplica en el siguiente frame.
+class ParamRamp {
+private:
+    uint16_t value;        // 8.8
+    int32_t stepPerFrame;  // 8.8
+    uint16_t framesLeft;
+    uint8_t target;
+    bool circular;         // El tono da la vuelta: se toma el camino corto
+
+    volatile uint8_t requestedTarget;
+    volatile uint16_t requestedMs;
+    volatile bool pending;
+
+    void retarget(uint8_t newTarget, uint16_t ms) {
+        target = newTarget;
+        framesLeft = (uint32_t)ms * 1000 / FRAME_INTERVAL_US;
+        if (framesLeft == 0) {
+            value = (uint16_t)target << 8;
+            return;
+        }
+
+        const int32_t delta = circular
+            ? (int32_t)(int16_t)(((uint16_t)target << 8) - value)
+            : ((int32_t)target << 8) - value;
+        stepPerFrame = delta / framesLeft;
+    }
+
+public:
+    explicit ParamRamp(uint8_t initial, bool wraps = false)
+        : value((uint16_t)initial << 8),
+          stepPerFrame(0),
+          framesLeft(0),
+          target(initial),
+          circular(wraps),
+          requestedTarget(initial),
+          requestedMs(0),
+          pending(false) {}
+
+    void set(uint8_t newTarget, uint16_t ms) {
+        requestedTarget = newTarget;
+        requestedMs = min(ms, MAX_PARAM_RAMP_MS);
+        pending = true;
+    }
+
+    // Sin rampa (configuración restaurada antes del primer frame)
+    void jump(uint8_t newValue) {
+        pending = false;
+        requestedTarget = newValue;
+        target = newValue;
+        value = (uint16_t)newValue << 8;
+        framesLeft = 0;
+    }
+
+    // Se llama una vez por frame desde el render
+    uint8_t advance() {
+        if (pending) {
+            pending = false;
+            retarget(requestedTarget, requestedMs);
+        }
+        if (framesLeft > 0) {
+            value += stepPerFrame;
+            if (--framesLeft == 0) {
+                value = (uint16_t)target << 8;
+            }
+        }
+        return value >> 8;
+    }
+
+    // Valor que se está mostrando
+    uint8_t get() const {
+        return value >> 8;
+    }
+
+    // Último objetivo pedido (lo que reportan la API y la configuración)
+    uint8_t getTarget() const {
+        return requestedTarget;
+    }
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef PIXEL_OPS_H
+#define PIXEL_OPS_H
+
+#include <FastLED.h>
+
+// Operaciones de color sobre palabras de 32 bits. Un color empaquetado es
+// 0x00RRGGBB; la interpolación procesa los cuatro bytes a la vez separando
+// los pares y los impares en carriles de 16 bits (SWAR), así que cuesta dos
+// multiplicaciones por color en lugar de tres por canal.
+namespace PixelOps {
+    inline uint32_t pack(const CRGB& color) {
+        return ((uint32_t)color.r << 16) | ((uint32_t)color.g << 8) | color.b;
+    }
+
+    inline uint32_t pack(uint8_t r, uint8_t g, uint8_t b) {
+        return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+    }
+
+    inline CRGB unpack(uint32_t color) {
+        return CRGB((uint8_t)(color >> 16), (uint8_t)(color >> 8), (uint8_t)color);
+    }
+
+    // Mezcla de a hacia b con t en [0, 256] (256 = b completo). Cada carril
+    // suma como máximo 255 * 256, así que no hay acarreo entre bytes.
+    inline uint32_t lerp8x4(uint32_t a, uint32_t b, uint16_t t) {
+        const uint32_t s = 256 - t;
+        const uint32_t even = (((a & 0x00FF00FF) * s + (b & 0x00FF00FF) * t) >> 8) & 0x00FF00FF;
+        const uint32_t odd = (((a >> 8) & 0x00FF00FF) * s + ((b >> 8) & 0x00FF00FF) * t) & 0xFF00FF00;
+        return even | odd;
+    }
+
+    // dst = mezcla de from hacia dst con t en [0, 256]. Los canales no
+    // importan, así que los buffers se recorren como bytes crudos de cuatro
+    // en cuatro; ambos deben estar alineados a 4 bytes.
+    inline void lerpPixels(CRGB* dst, const CRGB* from, uint16_t count, uint16_t t) {
+        uint8_t* out = static_cast<uint8_t*>(__builtin_assume_aligned(dst, 4));
+        const uint8_t* in = static_cast<const uint8_t*>(__builtin_assume_aligned(from, 4));
+        const size_t bytes = (size_t)count * sizeof(CRGB);
+
+        size_t i = 0;
+        for (; i + 4 <= bytes; i += 4) {
+            uint32_t a, b;
+            memcpy(&a, in + i, 4);
+            memcpy(&b, out + i, 4);
+            b = lerp8x4(a, b, t);
+            memcpy(out + i, &b, 4);
+        }
+        for (; i < bytes; i++) {
+            out[i] = (in[i] * (256 - t) + out[i] * t) >> 8;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef POST_FX_H
+#define POST_FX_H
+
+#include <FastLED.h>
+#include "config.h"
+#include "matrix_geometry.h"
+#include "pixel_ops.h"
+
+// Desenfoque y resplandor aplicados al frame de un efecto después de
+// render(). El filtro es separable (filas y luego columnas) y cada línea se
+// recorre con una suma corrida: entra un pixel y sale otro, así que el costo
+// no depende del radio. Los colores van empaquetados: rojo y azul comparten
+// una palabra en carriles de 16 bits y el verde va aparte.
+enum PostFxMode : uint8_t {
+    POSTFX_NONE,
+    POSTFX_BOX,       // Una pasada de caja
+    POSTFX_GAUSSIAN,  // Dos pasadas de caja (aproximación gaussiana)
+    POSTFX_BLOOM,     // Solo lo que supera el umbral, desenfocado y sumado
+    POSTFX_COUNT
+};
+
+struct PostFxSettings {
+    PostFxMode mode;
+    uint8_t radius;     // 1 a MAX_BLUR_RADIUS
+    uint8_t threshold;  // Resplandor: nivel de canal a partir del cual brilla
+};
+
+class PostFx {
+public:
+    static constexpr const char* NAMES[POSTFX_COUNT] = {"none", "box", "gaussian", "bloom"};
+
+    struct Stats {
+        uint32_t lastMicros;
+        uint32_t peakMicros;
+    };
+
+private:
+    static const uint8_t LINE_MAX = Matrix::WIDTH > Matrix::HEIGHT ? Matrix::WIDTH : Matrix::HEIGHT;
+
+    uint32_t work[NUM_LEDS];  // Frame empaquetado en orden x + y * WIDTH
+    uint32_t line[LINE_MAX];
+    Stats stats;
+    volatile bool resetRequested;
+
+    // Suma corrida sobre una línea de work. Fuera de la línea se repite el
+    // borde, salvo en el anillo, donde las columnas dan la vuelta.
+    void blurLine(uint32_t* data, uint8_t count, uint8_t stride, uint8_t radius, bool wrap) {
+        for (uint8_t i = 0; i < count; i++) {
+            line[i] = data[i * stride];
+        }
+
+        auto sample = [&](int16_t i) -> uint32_t {
+            if (i < 0) return line[wrap ? i + count : 0];
+            if (i >= count) return line[wrap ? i - count : count - 1];
+            return line[i];
+        };
+
+        // Redondeado hacia arriba: una ventana toda en 255 sigue dando 255
+        const uint8_t taps = radius * 2 + 1;
+        const uint32_t inverse = (65536 + taps - 1) / taps;
+
+        uint32_t redBlue = 0;
+        uint32_t green = 0;
+        for (int16_t i = -radius; i <= radius; i++) {
+            const uint32_t color = sample(i);
+            redBlue += color & 0x00FF00FF;
+            green += (color >> 8) & 0xFF;
+        }
+
+        for (uint8_t i = 0; i < count; i++) {
+            data[i * stride] = PixelOps::pack(((redBlue >> 16) * inverse) >> 16,
+                                              (green * inverse) >> 16,
+                                              ((redBlue & 0xFFFF) * inverse) >> 16);
+
+            // Cada carril contiene al pixel que sale, así que no hay préstamo
+            const uint32_t entering = sample(i + radius + 1);
+            const uint32_t leaving = sample(i - radius);
+            redBlue += (entering & 0x00FF00FF) - (leaving & 0x00FF00FF);
+            green += ((entering >> 8) & 0xFF) - ((leaving >> 8) & 0xFF);
+        }
+    }
+
+    void blurPass(uint8_t radius) {
+        for (uint8_t y = 0; y < Matrix::HEIGHT; y++) {
+            blurLine(work + y * Matrix::WIDTH, Matrix::WIDTH, 1, radius, Matrix::RING);
+        }
+        for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+            blurLine(work + x, Matrix::HEIGHT, Matrix::WIDTH, radius, false);
+        }
+    }
+
+public:
+    PostFx() : resetRequested(false) {
+        memset(&stats, 0, sizeof(stats));
+    }
+
+    static const char* name(PostFxMode mode) {
+        return mode < POSTFX_COUNT ? NAMES[mode] : NAMES[POSTFX_NONE];
+    }
+
+    // POSTFX_COUNT si el nombre no existe
+    static PostFxMode fromName(const char* value) {
+        for (uint8_t i = 0; i < POSTFX_COUNT; i++) {
+            if (strcmp(value, NAMES[i]) == 0) return static_cast<PostFxMode>(i);
+        }
+        return POSTFX_COUNT;
+    }
+
+    // Se llama desde el render con el frame recién dibujado
+    void apply(CRGB* leds, const PostFxSettings& settings) {
+        if (resetRequested) {
+            memset(&stats, 0, sizeof(stats));
+            resetRequested = false;
+        }
+        if (settings.mode == POSTFX_NONE || settings.mode >= POSTFX_COUNT) return;
+
+        const uint32_t start = micros();
+        const bool bloom = settings.mode == POSTFX_BLOOM;
+        const uint8_t radius = constrain(settings.radius, (uint8_t)1, MAX_BLUR_RADIUS);
+
+        for (uint8_t y = 0; y < Matrix::HEIGHT; y++) {
+            for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+                const CRGB& color = leds[Matrix::xy(x, y)];
+                work[y * Matrix::WIDTH + x] = bloom
+                    ? PixelOps::pack(qsub8(color.r, settings.threshold),
+                                     qsub8(color.g, settings.threshold),
+                                     qsub8(color.b, settings.threshold))
+                    : PixelOps::pack(color);
+            }
+        }
+
+        blurPass(radius);
+        if (settings.mode != POSTFX_BOX) {
+            blurPass(radius);
+        }
+
+        for (uint8_t y = 0; y < Matrix::HEIGHT; y++) {
+            for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+                CRGB& color = leds[Matrix::xy(x, y)];
+                const CRGB blurred = PixelOps::unpack(work[y * Matrix::WIDTH + x]);
+                if (bloom) {
+                    color += blurred;  // Suma con saturación
+                } else {
+                    color = blurred;
+                }
+            }
+        }
+
+        stats.lastMicros = micros() - start;
+        if (stats.lastMicros > stats.peakMicros) stats.peakMicros = stats.lastMicros;
+    }
+
+    void requestReset() {
+        resetRequested = true;
+    }
+
+    void printJson(Print& out) const {
+        out.printf("{\"lastUs\":%u,\"peakUs\":%u}", stats.lastMicros, stats.peakMicros);
+    }
+};
+
+#endif
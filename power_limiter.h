@@ -0,0 +1,129 @@
+#ifndef POWER_LIMITER_H
+#define POWER_LIMITER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Modelo de consumo y limitador de brillo, solo con enteros. Por cada frame
+// recibe la suma de cada canal (la calcula OutputPipeline::convert), estima
+// la corriente a brillo 255 y calcula el brillo máximo que cabe en
+// POWER_BUDGET_MA. Las sumas salen de la misma pasada que convierte el
+// frame, así que el límite de cada frame usa las del anterior: un cambio
+// brusco de contenido se corrige un frame (22 ms) después. Para evitar que
+// el brillo "bombee" con el contenido, el límite baja de inmediato pero
+// sube solo POWER_RELEASE_STEP por frame.
+class PowerLimiter {
+public:
+    struct Stats {
+        uint32_t estimatedMilliamps;  // Último frame, ya con el brillo aplicado
+        uint32_t peakMilliamps;
+        uint32_t limitedFrames;       // Frames en que se recortó el brillo
+        uint64_t energyNanojoules;
+    };
+
+private:
+    static const uint32_t IDLE_MILLIAMPS = (uint32_t)NUM_LEDS * LED_IDLE_MA;
+
+    uint32_t fullScaleMilliamps;  // Corriente del frame a brillo 255 (sin reposo)
+    uint8_t limit;
+    uint32_t lastFrameMicros;
+    bool hasLastFrame;
+    volatile bool resetRequested;
+    Stats stats;
+
+public:
+    PowerLimiter()
+        : fullScaleMilliamps(0),
+          limit(255),
+          lastFrameMicros(0),
+          hasLastFrame(false),
+          resetRequested(false) {
+        memset(&stats, 0, sizeof(stats));
+    }
+
+    // mA a brillo 255 de un frame con esas sumas por canal
+    static uint32_t fullScaleCurrent(uint32_t red, uint32_t green, uint32_t blue) {
+        return (red * LED_RED_MA + green * LED_GREEN_MA + blue * LED_BLUE_MA) / 255;
+    }
+
+    // Corriente estimada con el brillo de FastLED (que escala de 0 a 255)
+    static uint32_t currentAt(uint32_t fullScale, uint8_t brightness) {
+        return fullScale * brightness / 255 + IDLE_MILLIAMPS;
+    }
+
+    // Brillo máximo que mantiene la corriente dentro del presupuesto
+    static uint8_t maxBrightness(uint32_t fullScale) {
+        if (POWER_BUDGET_MA <= IDLE_MILLIAMPS) return 0;
+        if (fullScale == 0) return 255;
+        const uint32_t allowed = (uint32_t)(POWER_BUDGET_MA - IDLE_MILLIAMPS) * 255 / fullScale;
+        return allowed > 255 ? 255 : allowed;
+    }
+
+    // Brillo a aplicar al frame que se va a convertir, según el consumo del
+    // anterior
+    uint8_t limitFrame(uint8_t requested) {
+        const uint8_t cap = maxBrightness(fullScaleMilliamps);
+        if (cap < limit) {
+            limit = cap;
+        } else {
+            limit = min((uint16_t)cap, (uint16_t)(limit + POWER_RELEASE_STEP));
+        }
+
+        if (requested > limit) {
+            stats.limitedFrames++;
+            return limit;
+        }
+        return requested;
+    }
+
+    // Sumas por canal del frame recién convertido
+    void setFrameSums(uint32_t red, uint32_t green, uint32_t blue) {
+        fullScaleMilliamps = fullScaleCurrent(red, green, blue);
+    }
+
+    // Acumular la energía del frame mostrado con el brillo final
+    void recordFrame(uint8_t brightness, uint32_t now) {
+        if (resetRequested) {
+            memset(&stats, 0, sizeof(stats));
+            resetRequested = false;
+        }
+
+        const uint32_t milliamps = currentAt(fullScaleMilliamps, brightness);
+        stats.estimatedMilliamps = milliamps;
+        if (milliamps > stats.peakMilliamps) stats.peakMilliamps = milliamps;
+
+        // mA * V = mW; mW * us = nJ
+        if (hasLastFrame) {
+            stats.energyNanojoules += (uint64_t)milliamps * LED_VOLTAGE * (now - lastFrameMicros);
+        }
+        lastFrameMicros = now;
+        hasLastFrame = true;
+    }
+
+    // Los LEDs apagados solo consumen la corriente de reposo
+    void recordIdle(uint32_t now) {
+        fullScaleMilliamps = 0;
+        recordFrame(0, now);
+    }
+
+    void requestReset() {
+        resetRequested = true;
+    }
+
+    uint8_t getLimit() const {
+        return limit;
+    }
+
+    const Stats& getStats() const {
+        return stats;
+    }
+
+    void printJson(Print& out) const {
+        out.printf("{\"budgetMa\":%u,\"estimatedMa\":%u,\"peakMa\":%u,\"limit\":%u,"
+                   "\"limitedFrames\":%u,\"energyMwh\":%u}",
+                   (unsigned)POWER_BUDGET_MA, stats.estimatedMilliamps, stats.peakMilliamps, limit,
+                   stats.limitedFrames, (uint32_t)(stats.energyNanojoules / 3600000000ULL));
+    }
+};
+
+#endif
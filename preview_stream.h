@@ -0,0 +1,337 @@
+#ifndef PREVIEW_STREAM_H
+#define PREVIEW_STREAM_H
+
+#include <ESPAsyncWebServer.h>
+#include "config.h"
+#include "led_manager.h"
+
+// Transmite el contenido de leds[] por WebSocket para la vista previa del UI.
+// La codificación corre en su propia tarea (núcleo 0); el render solo copia
+// el frame cuando se le pide, así que nunca espera al codificador.
+//
+// Formato binario de cada mensaje:
+//   [0] tipo de frame, [1] número de secuencia, seguido de:
+//   FRAME_KEY:     repeticiones de [cuenta, r, g, b] (RLE)
+//   FRAME_DELTA:   repeticiones de [saltar, cuenta, cuenta * (r, g, b)] contra el frame anterior
+//   FRAME_PALETTE: [n], n * (r, g, b), índices de 4 bits por LED (dos por byte)
+class PreviewStream {
+private:
+    static const uint8_t FRAME_KEY = 0;
+    static const uint8_t FRAME_DELTA = 1;
+    static const uint8_t FRAME_PALETTE = 2;
+
+    static const uint8_t MAX_PALETTE_COLORS = 16;
+    static const size_t FRAME_BYTES = NUM_LEDS * 3;
+    static const size_t MAX_ENCODED = 2 + NUM_LEDS * 4;  // Peor caso del RLE
+
+    AsyncWebSocket ws;
+    LedManager* ledManager;
+    TaskHandle_t taskHandle;
+
+    uint8_t currentFrame[FRAME_BYTES];
+    uint8_t previousFrame[FRAME_BYTES];
+    uint8_t encoded[MAX_ENCODED];
+    uint8_t palette[MAX_PALETTE_COLORS * 3];
+
+    bool hasPrevious;
+    volatile bool forceKeyframe;
+    uint8_t sequence;
+    uint16_t framesSinceKeyframe;
+    unsigned long interval;
+
+    // Estadísticas
+    uint32_t framesSent;
+    uint32_t framesDropped;
+    uint32_t bytesSent;
+    uint32_t lastEncodeMicros;
+
+    bool samePixel(size_t i) const {
+        return memcmp(&currentFrame[i * 3], &previousFrame[i * 3], 3) == 0;
+    }
+
+    // Pixeles iguales seguidos desde i (máximo 255)
+    uint8_t runLength(size_t i) const {
+        const uint8_t* px = &currentFrame[i * 3];
+        uint8_t run = 1;
+        while (i + run < NUM_LEDS && run < 255 &&
+               memcmp(px, &currentFrame[(i + run) * 3], 3) == 0) {
+            run++;
+        }
+        return run;
+    }
+
+    // Recorre el frame como grupos [saltar, cuenta] contra el anterior;
+    // visit(start, skip, count) recibe cada grupo
+    template <typename Visit>
+    void forEachDeltaGroup(Visit visit) const {
+        size_t i = 0;
+        while (i < NUM_LEDS) {
+            uint8_t skip = 0;
+            while (i < NUM_LEDS && skip < 255 && samePixel(i)) {
+                skip++;
+                i++;
+            }
+            const size_t start = i;
+            uint8_t count = 0;
+            while (i < NUM_LEDS && count < 255 && !samePixel(i)) {
+                count++;
+                i++;
+            }
+            visit(start, skip, count);
+        }
+    }
+
+    size_t keyframeLength() const {
+        size_t runs = 0;
+        for (size_t i = 0; i < NUM_LEDS; i += runLength(i)) {
+            runs++;
+        }
+        return 2 + runs * 4;
+    }
+
+    size_t deltaLength() const {
+        size_t length = 2;
+        forEachDeltaGroup([&](size_t, uint8_t, uint8_t count) {
+            length += 2 + count * 3;
+        });
+        return length;
+    }
+
+    static size_t paletteLength(uint8_t colors) {
+        return 3 + colors * 3 + (NUM_LEDS + 1) / 2;
+    }
+
+    // Llena palette con los colores del frame; 0 si hay más de MAX_PALETTE_COLORS
+    uint8_t collectPalette() {
+        uint8_t colors = 0;
+        for (size_t i = 0; i < NUM_LEDS; i++) {
+            const uint8_t* px = &currentFrame[i * 3];
+            uint8_t index = 0;
+            while (index < colors && memcmp(&palette[index * 3], px, 3) != 0) {
+                index++;
+            }
+            if (index == colors) {
+                if (colors == MAX_PALETTE_COLORS) return 0;
+                memcpy(&palette[colors * 3], px, 3);
+                colors++;
+            }
+        }
+        return colors;
+    }
+
+    size_t encodeKeyframe() {
+        size_t out = 0;
+        encoded[out++] = FRAME_KEY;
+        encoded[out++] = sequence;
+
+        size_t i = 0;
+        while (i < NUM_LEDS) {
+            const uint8_t* px = &currentFrame[i * 3];
+            const uint8_t run = runLength(i);
+            encoded[out++] = run;
+            encoded[out++] = px[0];
+            encoded[out++] = px[1];
+            encoded[out++] = px[2];
+            i += run;
+        }
+        return out;
+    }
+
+    // Usa la paleta que dejó collectPalette()
+    size_t encodePalette(uint8_t colors) {
+        encoded[0] = FRAME_PALETTE;
+        encoded[1] = sequence;
+        encoded[2] = colors;
+        memcpy(&encoded[3], palette, colors * 3);
+
+        uint8_t* indices = &encoded[3 + colors * 3];
+        memset(indices, 0, (NUM_LEDS + 1) / 2);
+        for (size_t i = 0; i < NUM_LEDS; i++) {
+            uint8_t index = 0;
+            while (memcmp(&palette[index * 3], &currentFrame[i * 3], 3) != 0) {
+                index++;
+            }
+            indices[i >> 1] |= (i & 1) ? (index << 4) : index;
+        }
+        return paletteLength(colors);
+    }
+
+    size_t encodeDelta() {
+        size_t out = 0;
+        encoded[out++] = FRAME_DELTA;
+        encoded[out++] = sequence;
+
+        forEachDeltaGroup([&](size_t start, uint8_t skip, uint8_t count) {
+            encoded[out++] = skip;
+            encoded[out++] = count;
+            memcpy(&encoded[out], &currentFrame[start * 3], count * 3);
+            out += count * 3;
+        });
+        return out;
+    }
+
+    // Mide las codificaciones posibles y escribe la más pequeña. Nunca pasa
+    // del keyframe, así que siempre cabe en MAX_ENCODED.
+    size_t encodeFrame() {
+        const bool keyframeDue = forceKeyframe || !hasPrevious ||
+                                 framesSinceKeyframe >= PREVIEW_KEYFRAME_INTERVAL;
+
+        uint8_t type = FRAME_KEY;
+        size_t best = keyframeLength();
+
+        const uint8_t colors = collectPalette();
+        if (colors > 0 && paletteLength(colors) < best) {
+            type = FRAME_PALETTE;
+            best = paletteLength(colors);
+        }
+        if (!keyframeDue && deltaLength() < best) {
+            type = FRAME_DELTA;
+        }
+
+        size_t length;
+        switch (type) {
+            case FRAME_DELTA:
+                length = encodeDelta();
+                framesSinceKeyframe++;
+                return length;
+            case FRAME_PALETTE:
+                length = encodePalette(colors);
+                break;
+            default:
+                length = encodeKeyframe();
+                break;
+        }
+        framesSinceKeyframe = 0;
+        forceKeyframe = false;
+        return length;
+    }
+
+    // Ajustar la cadencia para que el codificador no pase de su presupuesto
+    void adaptInterval() {
+        if (lastEncodeMicros > PREVIEW_CPU_BUDGET_US) {
+            interval = min(interval * 2, PREVIEW_MAX_INTERVAL);
+        } else if (interval > PREVIEW_INTERVAL && lastEncodeMicros < PREVIEW_CPU_BUDGET_US / 2) {
+            interval = max(interval / 2, PREVIEW_INTERVAL);
+        }
+    }
+
+    bool waitForSnapshot() {
+        if (!ledManager->requestSnapshot(currentFrame)) return false;
+
+        int waited = 0;
+        while (!ledManager->isSnapshotReady() && waited < PREVIEW_SNAPSHOT_TIMEOUT) {
+            vTaskDelay(1);
+            waited++;
+        }
+        if (!ledManager->isSnapshotReady()) {
+            ledManager->cancelSnapshot();
+            return false;
+        }
+        return true;
+    }
+
+    void sendFrame() {
+        if (!waitForSnapshot()) {
+            framesDropped++;
+            return;
+        }
+
+        // Si algún cliente tiene la cola llena se descarta el frame
+        if (!ws.availableForWriteAll()) {
+            framesDropped++;
+            forceKeyframe = true;
+            return;
+        }
+
+        const unsigned long start = micros();
+        const size_t length = encodeFrame();
+        lastEncodeMicros = micros() - start;
+
+        ws.binaryAll(encoded, length);
+        memcpy(previousFrame, currentFrame, FRAME_BYTES);
+        hasPrevious = true;
+        sequence++;
+        framesSent++;
+        bytesSent += length;
+        adaptInterval();
+    }
+
+    void run() {
+        for (;;) {
+            ws.cleanupClients();
+
+            if (ws.count() == 0) {
+                hasPrevious = false;
+                vTaskDelay(pdMS_TO_TICKS(PREVIEW_IDLE_DELAY));
+                continue;
+            }
+
+            sendFrame();
+            vTaskDelay(pdMS_TO_TICKS(interval));
+        }
+    }
+
+    static void taskEntry(void* param) {
+        static_cast<PreviewStream*>(param)->run();
+    }
+
+public:
+    PreviewStream(LedManager* ledMgr)
+        : ws("/ws/preview"),
+          ledManager(ledMgr),
+          taskHandle(nullptr),
+          hasPrevious(false),
+          forceKeyframe(true),
+          sequence(0),
+          framesSinceKeyframe(0),
+          interval(PREVIEW_INTERVAL),
+          framesSent(0),
+          framesDropped(0),
+          bytesSent(0),
+          lastEncodeMicros(0) {}
+
+    void begin(AsyncWebServer& server) {
+        ws.onEvent([this](AsyncWebSocket* socket, AsyncWebSocketClient* client,
+                          AwsEventType type, void* arg, uint8_t* data, size_t len) {
+            // Un cliente nuevo necesita un frame completo
+            if (type == WS_EVT_CONNECT) {
+                forceKeyframe = true;
+            }
+        });
+        server.addHandler(&ws);
+
+        Serial.printf("Memoria de la vista previa: %u bytes (presupuesto %u)\n",
+                      (unsigned)sizeof(PreviewStream), (unsigned)PREVIEW_MEMORY_BUDGET);
+        xTaskCreatePinnedToCore(taskEntry, "preview", PREVIEW_TASK_STACK, this, 1,
+                                &taskHandle, PREVIEW_TASK_CORE);
+    }
+
+    size_t getClientCount() const {
+        return ws.count();
+    }
+
+    uint32_t getFramesSent() const {
+        return framesSent;
+    }
+
+    uint32_t getFramesDropped() const {
+        return framesDropped;
+    }
+
+    uint32_t getBytesSent() const {
+        return bytesSent;
+    }
+
+    uint32_t getLastEncodeMicros() const {
+        return lastEncodeMicros;
+    }
+
+    unsigned long getInterval() const {
+        return interval;
+    }
+};
+
+static_assert(sizeof(PreviewStream) <= PREVIEW_MEMORY_BUDGET,
+              "PreviewStream excede PREVIEW_MEMORY_BUDGET");
+
+#endif
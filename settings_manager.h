@@ -0,0 +1,72 @@
+#ifndef SETTINGS_MANAGER_H
+#define SETTINGS_MANAGER_H
+
+#include "config.h"
+#include "led_manager.h"
+#include "settings_store.h"
+
+// Guarda la configuración del LedManager en NVS (ver settings_store.h). Las
+// escrituras se retrasan (write-behind) hasta que los cambios se calman,
+// para no desgastar la flash al arrastrar un slider.
+class SettingsManager {
+private:
+    LedManager* ledManager;
+    SettingsStore store;
+    WriteBehind writeBehind;
+
+public:
+    SettingsManager(LedManager* ledMgr) : ledManager(ledMgr) {}
+
+    // Cargar la configuración y aplicarla antes del primer frame
+    void begin() {
+        LedSettings settings;
+        if (store.begin(settings)) {
+            ledManager->applySettings(settings);
+            Serial.printf("Configuración restaurada (secuencia %u)\n", store.getSequence());
+        } else {
+            Serial.println("Sin configuración guardada, usando valores por defecto");
+        }
+
+        writeBehind.begin(ledManager->getChangeCounter());
+        BootTimeline::instance().mark(BOOT_SETTINGS_RESTORED);
+    }
+
+    void handle() {
+        if (writeBehind.due(ledManager->getChangeCounter(), millis())) {
+            store.save(ledManager->captureSettings());
+        }
+    }
+
+    // Escribir inmediatamente lo pendiente (antes de reiniciar)
+    void flush() {
+        if (writeBehind.flushDue(ledManager->getChangeCounter())) {
+            store.save(ledManager->captureSettings());
+        }
+    }
+
+    uint32_t getFlashWrites() const {
+        return store.getFlashWrites();
+    }
+
+    uint32_t getSkippedWrites() const {
+        return store.getSkippedWrites();
+    }
+
+    uint32_t getFailedWrites() const {
+        return store.getFailedWrites();
+    }
+
+    uint32_t getCorruptSlots() const {
+        return store.getCorruptSlots();
+    }
+
+    uint32_t getSequence() const {
+        return store.getSequence();
+    }
+
+    bool isDirty() const {
+        return writeBehind.isDirty();
+    }
+};
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+
+#include <Preferences.h>
+#include "config.h"
+#include "led_settings.h"
+
+// Registro binario versionado de LedSettings en NVS. Se alternan dos
+// ranuras con número de secuencia y CRC: si se corta la energía a mitad de
+// una escritura, la ranura dañada no pasa el CRC y se usa la anterior.
+class SettingsStore {
+private:
+    static const uint8_t RECORD_VERSION = 1;
+    static constexpr const char* NAMESPACE = "ledfirepit";
+
+    struct __attribute__((packed)) SettingsRecord {
+        uint8_t version;
+        uint32_t sequence;
+        LedSettings settings;
+        uint16_t crc;
+    };
+
+    Preferences preferences;
+
+    SettingsRecord lastSaved;
+    bool hasSaved;
+    uint8_t nextSlot;
+
+    // Contadores de escrituras a flash
+    uint32_t flashWrites;
+    uint32_t skippedWrites;
+    uint32_t failedWrites;
+    uint32_t corruptSlots;
+
+    static const char* slotKey(uint8_t slot) {
+        return slot == 0 ? "slotA" : "slotB";
+    }
+
+    static uint16_t crc16(const uint8_t* data, size_t length) {
+        uint16_t crc = 0xFFFF;
+        for (size_t i = 0; i < length; i++) {
+            crc ^= (uint16_t)data[i] << 8;
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+            }
+        }
+        return crc;
+    }
+
+    static uint16_t recordCrc(const SettingsRecord& record) {
+        return crc16(reinterpret_cast<const uint8_t*>(&record), offsetof(SettingsRecord, crc));
+    }
+
+    bool readSlot(uint8_t slot, SettingsRecord& record) {
+        if (preferences.getBytesLength(slotKey(slot)) != sizeof(SettingsRecord)) {
+            return false;
+        }
+        preferences.getBytes(slotKey(slot), &record, sizeof(SettingsRecord));
+        if (record.version != RECORD_VERSION || record.crc != recordCrc(record)) {
+            corruptSlots++;
+            return false;
+        }
+        return true;
+    }
+
+public:
+    SettingsStore()
+        : hasSaved(false),
+          nextSlot(0),
+          flashWrites(0),
+          skippedWrites(0),
+          failedWrites(0),
+          corruptSlots(0) {}
+
+    // Abrir NVS y leer el registro más reciente que sea válido
+    bool begin(LedSettings& restored) {
+        preferences.begin(NAMESPACE, false);
+
+        SettingsRecord slots[2];
+        bool valid[2] = {readSlot(0, slots[0]), readSlot(1, slots[1])};
+
+        int8_t newest = -1;
+        if (valid[0] && valid[1]) {
+            newest = slots[1].sequence > slots[0].sequence ? 1 : 0;
+        } else if (valid[0] || valid[1]) {
+            newest = valid[0] ? 0 : 1;
+        }
+        if (newest < 0) return false;
+
+        lastSaved = slots[newest];
+        hasSaved = true;
+        nextSlot = newest ^ 1;
+        restored = lastSaved.settings;
+        return true;
+    }
+
+    void save(const LedSettings& settings) {
+        // Evitar escrituras si nada cambió realmente (p. ej. slider que volvió al mismo valor)
+        if (hasSaved && memcmp(&lastSaved.settings, &settings, sizeof(LedSettings)) == 0) {
+            skippedWrites++;
+            return;
+        }
+
+        SettingsRecord record;
+        record.version = RECORD_VERSION;
+        record.sequence = hasSaved ? lastSaved.sequence + 1 : 1;
+        record.settings = settings;
+        record.crc = recordCrc(record);
+
+        if (preferences.putBytes(slotKey(nextSlot), &record, sizeof(record)) != sizeof(record)) {
+            failedWrites++;
+            Serial.println("Error al guardar la configuración");
+            return;
+        }
+
+        lastSaved = record;
+        hasSaved = true;
+        nextSlot ^= 1;
+        flashWrites++;
+        Serial.printf("Configuración guardada (secuencia %u, escrituras %u)\n",
+                      record.sequence, flashWrites);
+    }
+
+    uint32_t getFlashWrites() const {
+        return flashWrites;
+    }
+
+    uint32_t getSkippedWrites() const {
+        return skippedWrites;
+    }
+
+    uint32_t getFailedWrites() const {
+        return failedWrites;
+    }
+
+    uint32_t getCorruptSlots() const {
+        return corruptSlots;
+    }
+
+    uint32_t getSequence() const {
+        return hasSaved ? lastSaved.sequence : 0;
+    }
+};
+
+// Escritura diferida: decide cuándo guardar a partir del contador de
+// cambios. Se guarda cuando los cambios se calman SETTINGS_SAVE_DELAY, o
+// como máximo SETTINGS_MAX_DELAY después del primero pendiente.
+class WriteBehind {
+private:
+    uint32_t lastSeenChange;
+    unsigned long firstPendingChange;
+    unsigned long lastPendingChange;
+    bool dirty;
+
+public:
+    WriteBehind()
+        : lastSeenChange(0),
+          firstPendingChange(0),
+          lastPendingChange(0),
+          dirty(false) {}
+
+    // Lo que ya está en NVS no cuenta como cambio
+    void begin(uint32_t change) {
+        lastSeenChange = change;
+        dirty = false;
+    }
+
+    // true si hay que guardar ahora
+    bool due(uint32_t change, unsigned long now) {
+        if (change != lastSeenChange) {
+            lastSeenChange = change;
+            lastPendingChange = now;
+            if (!dirty) {
+                firstPendingChange = now;
+                dirty = true;
+            }
+        }
+
+        if (!dirty) return false;
+        if (now - lastPendingChange >= SETTINGS_SAVE_DELAY ||
+            now - firstPendingChange >= SETTINGS_MAX_DELAY) {
+            dirty = false;
+            return true;
+        }
+        return false;
+    }
+
+    // true si queda algo sin guardar (antes de reiniciar)
+    bool flushDue(uint32_t change) {
+        const bool pending = change != lastSeenChange || dirty;
+        lastSeenChange = change;
+        dirty = false;
+        return pending;
+    }
+
+    bool isDirty() const {
+        return dirty;
+    }
+};
+
+#endif
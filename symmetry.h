@@ -0,0 +1,88 @@
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include <FastLED.h>
+#include "config.h"
+#include "matrix_geometry.h"
+
+// Simetría de render. El efecto dibuja solo la región fundamental (que
+// siempre empieza en la esquina inferior izquierda) y replicate() copia el
+// resto. Las copias van por Matrix::xy, así que funcionan igual con el
+// cableado en serpentina.
+enum SymmetryMode : uint8_t {
+    SYMMETRY_NONE,
+    SYMMETRY_HORIZONTAL,  // Espejo izquierda/derecha
+    SYMMETRY_VERTICAL,    // Espejo arriba/abajo
+    SYMMETRY_QUAD,        // Ambos espejos: se calcula un cuarto
+    SYMMETRY_ROTATIONAL,  // Giro de 180 grados: se calcula la mitad inferior
+    SYMMETRY_COUNT
+};
+
+namespace Symmetry {
+    constexpr const char* NAMES[SYMMETRY_COUNT] = {"none", "horizontal", "vertical", "quad", "rotational"};
+
+    inline const char* name(SymmetryMode mode) {
+        return mode < SYMMETRY_COUNT ? NAMES[mode] : NAMES[SYMMETRY_NONE];
+    }
+
+    // SYMMETRY_COUNT si el nombre no existe
+    inline SymmetryMode fromName(const char* value) {
+        for (uint8_t i = 0; i < SYMMETRY_COUNT; i++) {
+            if (strcmp(value, NAMES[i]) == 0) return static_cast<SymmetryMode>(i);
+        }
+        return SYMMETRY_COUNT;
+    }
+
+    // Columnas y filas que el efecto debe calcular (la central se incluye)
+    inline uint8_t regionWidth(SymmetryMode mode) {
+        return mode == SYMMETRY_HORIZONTAL || mode == SYMMETRY_QUAD
+            ? (Matrix::WIDTH + 1) / 2 : Matrix::WIDTH;
+    }
+
+    inline uint8_t regionHeight(SymmetryMode mode) {
+        return mode == SYMMETRY_VERTICAL || mode == SYMMETRY_QUAD || mode == SYMMETRY_ROTATIONAL
+            ? (Matrix::HEIGHT + 1) / 2 : Matrix::HEIGHT;
+    }
+
+    // Copiar la región fundamental al resto de la matriz
+    inline void replicate(CRGB* leds, SymmetryMode mode) {
+        const uint8_t width = regionWidth(mode);
+        const uint8_t height = regionHeight(mode);
+
+        switch (mode) {
+            case SYMMETRY_HORIZONTAL:
+            case SYMMETRY_VERTICAL:
+            case SYMMETRY_QUAD:
+                if (width < Matrix::WIDTH) {
+                    for (uint8_t y = 0; y < height; y++) {
+                        for (uint8_t x = width; x < Matrix::WIDTH; x++) {
+                            leds[Matrix::xy(x, y)] = leds[Matrix::xy(Matrix::WIDTH - 1 - x, y)];
+                        }
+                    }
+                }
+                if (height < Matrix::HEIGHT) {
+                    for (uint8_t y = height; y < Matrix::HEIGHT; y++) {
+                        const uint8_t source = Matrix::HEIGHT - 1 - y;
+                        for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+                            leds[Matrix::xy(x, y)] = leds[Matrix::xy(x, source)];
+                        }
+                    }
+                }
+                break;
+
+            case SYMMETRY_ROTATIONAL:
+                for (uint8_t y = height; y < Matrix::HEIGHT; y++) {
+                    const uint8_t source = Matrix::HEIGHT - 1 - y;
+                    for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+                        leds[Matrix::xy(x, y)] = leds[Matrix::xy(Matrix::WIDTH - 1 - x, source)];
+                    }
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+#endif
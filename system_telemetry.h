@@ -0,0 +1,184 @@
+#ifndef SYSTEM_TELEMETRY_H
+#define SYSTEM_TELEMETRY_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <ESPAsyncWebServer.h>
+#include <esp_freertos_hooks.h>
+#include "config.h"
+
+// Telemetría del sistema: memoria, pilas de tareas, carga por núcleo,
+// vueltas del loop y RSSI. sample() se llama desde la rueda de la tarea de
+// red y guarda cada muestra en un buffer circular que /api/system devuelve
+// como serie de tiempo.
+class SystemTelemetry {
+public:
+    static const uint8_t MAX_TASKS = 6;
+
+    struct Sample {
+        uint32_t uptime;                // Segundos desde el arranque
+        uint32_t freeHeap;
+        uint32_t largestBlock;          // Bloque libre más grande
+        uint32_t minFreeHeap;           // Mínimo histórico
+        uint32_t loopsPerSecond;
+        uint16_t stackFree[MAX_TASKS];  // Bytes libres mínimos de cada tarea
+        uint8_t cpuLoad[2];             // Porcentaje por núcleo
+        int8_t rssi;
+    };
+
+private:
+    // Los ganchos de inactividad cuentan un tick por cada vuelta de la tarea
+    // IDLE; como devuelven true el núcleo espera la siguiente interrupción, así
+    // que las cuentas equivalen a ticks sin trabajo.
+    static volatile uint32_t* idleTicks() {
+        static volatile uint32_t ticks[2] = {0, 0};
+        return ticks;
+    }
+
+    static bool idleHook0() {
+        idleTicks()[0]++;
+        return true;
+    }
+
+    static bool idleHook1() {
+        idleTicks()[1]++;
+        return true;
+    }
+
+    Sample samples[TELEMETRY_HISTORY];
+    uint16_t head;      // Próxima posición a escribir
+    uint16_t count;
+
+    const char* taskNames[MAX_TASKS];
+    uint8_t taskCount;
+
+    volatile uint32_t loopCounter;
+    uint32_t lastLoopCount;
+    uint32_t lastIdle[2];
+    unsigned long lastSampleMillis;
+
+    const Sample& at(uint16_t age) const {
+        return samples[(head + TELEMETRY_HISTORY - 1 - age) % TELEMETRY_HISTORY];
+    }
+
+    void writeSample(Print& out, const Sample& sample) const {
+        out.printf("{\"uptime\":%u,\"freeHeap\":%u,\"largestBlock\":%u,\"minFreeHeap\":%u,"
+                   "\"loopsPerSecond\":%u,\"cpu\":[%u,%u],\"rssi\":%d,\"stackFree\":{",
+                   sample.uptime, sample.freeHeap, sample.largestBlock, sample.minFreeHeap,
+                   sample.loopsPerSecond, sample.cpuLoad[0], sample.cpuLoad[1], sample.rssi);
+        for (uint8_t i = 0; i < taskCount; i++) {
+            out.printf("%s\"%s\":%u", i > 0 ? "," : "", taskNames[i], sample.stackFree[i]);
+        }
+        out.print("}}");
+    }
+
+    void handleRequest(AsyncWebServerRequest* request) {
+        // ?samples=N limita la serie a las N muestras más recientes
+        uint16_t limit = count;
+        if (request->hasParam("samples")) {
+            const long requested = request->getParam("samples")->value().toInt();
+            limit = requested < 0 ? 0 : min((long)count, requested);
+        }
+
+        AsyncResponseStream* response = request->beginResponseStream("application/json");
+        response->printf("{\"interval\":%lu,\"capacity\":%u,\"count\":%u,\"current\":",
+                         TELEMETRY_SAMPLE_INTERVAL, TELEMETRY_HISTORY, limit);
+        if (count > 0) {
+            writeSample(*response, at(0));
+        } else {
+            response->print("null");
+        }
+
+        // Serie de la más antigua a la más reciente
+        response->print(",\"history\":[");
+        for (uint16_t age = limit; age > 0; age--) {
+            if (age != limit) response->print(",");
+            writeSample(*response, at(age - 1));
+        }
+        response->print("]}");
+        request->send(response);
+    }
+
+public:
+    SystemTelemetry()
+        : head(0),
+          count(0),
+          taskCount(0),
+          loopCounter(0),
+          lastLoopCount(0),
+          lastSampleMillis(0) {
+        lastIdle[0] = 0;
+        lastIdle[1] = 0;
+    }
+
+    // Tareas cuyo margen de pila se registra (se buscan por nombre)
+    void trackTask(const char* name) {
+        if (taskCount < MAX_TASKS) {
+            taskNames[taskCount++] = name;
+        }
+    }
+
+    void begin() {
+        esp_register_freertos_idle_hook_for_cpu(idleHook0, 0);
+        esp_register_freertos_idle_hook_for_cpu(idleHook1, 1);
+        lastIdle[0] = idleTicks()[0];
+        lastIdle[1] = idleTicks()[1];
+        lastSampleMillis = millis();
+    }
+
+    void registerRoutes(AsyncWebServer& server) {
+        server.on("/api/system", HTTP_GET, [this](AsyncWebServerRequest* request) {
+            handleRequest(request);
+        });
+    }
+
+    // Se llama en cada vuelta de loop()
+    void countLoop() {
+        loopCounter++;
+    }
+
+    void sample() {
+        const unsigned long now = millis();
+        const unsigned long elapsed = max(now - lastSampleMillis, 1UL);
+        lastSampleMillis = now;
+
+        Sample& sample = samples[head];
+        sample.uptime = now / 1000;
+        sample.freeHeap = ESP.getFreeHeap();
+        sample.largestBlock = ESP.getMaxAllocHeap();
+        sample.minFreeHeap = ESP.getMinFreeHeap();
+
+        const uint32_t loops = loopCounter;
+        sample.loopsPerSecond = (uint64_t)(loops - lastLoopCount) * 1000 / elapsed;
+        lastLoopCount = loops;
+
+        const uint32_t expectedTicks = max((uint32_t)((uint64_t)elapsed * configTICK_RATE_HZ / 1000), (uint32_t)1);
+        for (uint8_t core = 0; core < 2; core++) {
+            const uint32_t idle = idleTicks()[core];
+            const uint32_t idleDelta = min(idle - lastIdle[core], expectedTicks);
+            lastIdle[core] = idle;
+            sample.cpuLoad[core] = 100 - idleDelta * 100 / expectedTicks;
+        }
+
+        for (uint8_t i = 0; i < MAX_TASKS; i++) {
+            TaskHandle_t task = i < taskCount ? xTaskGetHandle(taskNames[i]) : nullptr;
+            sample.stackFree[i] = task != nullptr ? uxTaskGetStackHighWaterMark(task) : 0;
+        }
+
+        sample.rssi = WiFi.status() == WL_CONNECTED ? WiFi.RSSI() : 0;
+
+        head = (head + 1) % TELEMETRY_HISTORY;
+        if (count < TELEMETRY_HISTORY) count++;
+    }
+
+    // Muestra más reciente (age = 0) o anteriores
+    const Sample* getSample(uint16_t age) const {
+        return age < count ? &at(age) : nullptr;
+    }
+
+    uint16_t getSampleCount() const {
+        return count;
+    }
+};
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Lo mínimo del core de Arduino para compilar los módulos puros en el host.
+// El reloj es falso: solo avanza con HostClock o con delay(), así cada
+// prueba controla el tiempo y un delay() que se cuele en un camino que no
+// debe bloquear se nota como tiempo perdido.
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <math.h>
+#include <algorithm>
+#include <functional>
+
+using std::min;
+using std::max;
+
+#define PROGMEM
+#define IRAM_ATTR
+
+namespace HostClock {
+    inline uint64_t nowMicros = 0;
+
+    inline void set(uint64_t micros) {
+        nowMicros = micros;
+    }
+
+    inline void advanceMicros(uint64_t micros) {
+        nowMicros += micros;
+    }
+
+    inline void advanceMillis(uint64_t millis) {
+        nowMicros += millis * 1000;
+    }
+}
+
+inline unsigned long micros() {
+    return HostClock::nowMicros;
+}
+
+inline unsigned long millis() {
+    return HostClock::nowMicros / 1000;
+}
+
+inline void delay(unsigned long ms) {
+    HostClock::advanceMillis(ms);
+}
+
+inline void yield() {}
+
+// Contador de ciclos atado al reloj falso, como un ESP32 a 240 MHz
+class HostEsp {
+public:
+    static const uint32_t CPU_MHZ = 240;
+
+    uint32_t getCycleCount() const {
+        return (uint32_t)(HostClock::nowMicros * CPU_MHZ);
+    }
+
+    uint32_t getCpuFreqMHz() const {
+        return CPU_MHZ;
+    }
+};
+
+inline HostEsp ESP;
+
+// random() de Arduino con una semilla fija: cada corrida ve la misma secuencia
+namespace HostRandom {
+    inline uint32_t state = 1;
+
+    inline uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+}
+
+inline void randomSeed(unsigned long seed) {
+    HostRandom::state = seed != 0 ? seed : 1;
+}
+
+inline long random(long howBig) {
+    return howBig > 0 ? HostRandom::next() % howBig : 0;
+}
+
+inline long random(long howSmall, long howBig) {
+    return howBig > howSmall ? howSmall + random(howBig - howSmall) : howSmall;
+}
+
+template <typename T, typename L, typename H>
+T constrain(T value, L low, H high) {
+    return value < low ? low : (value > high ? high : value);
+}
+
+// Salida de texto: las clases derivadas solo implementan write()
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(const uint8_t* data, size_t len) = 0;
+
+    size_t print(const char* text) {
+        return write(reinterpret_cast<const uint8_t*>(text), strlen(text));
+    }
+
+    size_t println(const char* text = "") {
+        return print(text) + print("\n");
+    }
+
+    size_t println(int value) {
+        char text[16];
+        snprintf(text, sizeof(text), "%d", value);
+        return println(text);
+    }
+
+    size_t printf(const char* format, ...) {
+        char text[512];
+        va_list args;
+        va_start(args, format);
+        const int written = vsnprintf(text, sizeof(text), format, args);
+        va_end(args);
+        return written > 0 ? write(reinterpret_cast<const uint8_t*>(text), strlen(text)) : 0;
+    }
+};
+
+// El puerto serie solo imprime con HOST_SERIAL=1 en el entorno
+class HostSerial : public Print {
+public:
+    void begin(unsigned long) {}
+
+    size_t write(const uint8_t* data, size_t len) override {
+        static const bool verbose = getenv("HOST_SERIAL") != nullptr;
+        return verbose ? fwrite(data, 1, len, stdout) : len;
+    }
+};
+
+inline HostSerial Serial;
+
+#endif
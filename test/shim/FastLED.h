@@ -0,0 +1,78 @@
+#ifndef HOST_FASTLED_H
+#define HOST_FASTLED_H
+
+#include <Arduino.h>
+
+// Solo lo que usan los módulos probados en el host: CRGB con la misma
+// disposición en memoria (r, g, b contiguos), CHSV, la suma con
+// saturación, qsub8 y fill_solid. La
+// conversión de CHSV es un espectro lineal, no el arcoíris de FastLED:
+// las pruebas no dependen de los tonos exactos.
+struct CHSV {
+    uint8_t h;
+    uint8_t s;
+    uint8_t v;
+
+    constexpr CHSV(uint8_t hue, uint8_t saturation, uint8_t value) : h(hue), s(saturation), v(value) {}
+};
+
+struct CRGB {
+    union {
+        struct {
+            uint8_t r;
+            uint8_t g;
+            uint8_t b;
+        };
+        uint8_t raw[3];
+    };
+
+    enum HTMLColorCode : uint32_t {
+        Black = 0x000000,
+        Cyan = 0x00FFFF,
+        White = 0xFFFFFF
+    };
+
+    CRGB() : r(0), g(0), b(0) {}
+    constexpr CRGB(uint8_t red, uint8_t green, uint8_t blue) : r(red), g(green), b(blue) {}
+    CRGB(HTMLColorCode code) : r(code >> 16), g(code >> 8), b(code) {}
+
+    CRGB(const CHSV& hsv) {
+        const uint8_t sector = hsv.h / 43;
+        const uint8_t rise = (hsv.h - sector * 43) * 6;
+        const uint8_t floor = hsv.v * (255 - hsv.s) / 255;
+        const uint8_t up = floor + (hsv.v - floor) * rise / 255;
+        const uint8_t down = hsv.v - (hsv.v - floor) * rise / 255;
+        switch (sector) {
+            case 0: r = hsv.v; g = up; b = floor; break;
+            case 1: r = down; g = hsv.v; b = floor; break;
+            case 2: r = floor; g = hsv.v; b = up; break;
+            case 3: r = floor; g = down; b = hsv.v; break;
+            case 4: r = up; g = floor; b = hsv.v; break;
+            default: r = hsv.v; g = floor; b = down; break;
+        }
+    }
+
+    // Suma con saturación por canal, como en FastLED
+    CRGB& operator+=(const CRGB& other) {
+        r = r + other.r > 255 ? 255 : r + other.r;
+        g = g + other.g > 255 ? 255 : g + other.g;
+        b = b + other.b > 255 ? 255 : b + other.b;
+        return *this;
+    }
+
+    bool operator==(const CRGB& other) const {
+        return r == other.r && g == other.g && b == other.b;
+    }
+};
+
+static_assert(sizeof(CRGB) == 3, "CRGB debe ocupar tres bytes como en FastLED");
+
+inline uint8_t qsub8(uint8_t a, uint8_t b) {
+    return a > b ? a - b : 0;
+}
+
+inline void fill_solid(CRGB* leds, int count, const CRGB& color) {
+    for (int i = 0; i < count; i++) leds[i] = color;
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef HOST_NTPCLIENT_H
+#define HOST_NTPCLIENT_H
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+
+// Reloj NTP sin red: la hora sale del reloj falso más el desfase
+class NTPClient {
+private:
+    long offset;
+
+public:
+    NTPClient(WiFiUDP&, const char*, long timeOffset) : offset(timeOffset) {}
+
+    void begin() {}
+
+    bool update() {
+        return true;
+    }
+
+    int getHours() const {
+        return ((millis() / 1000 + offset) % 86400) / 3600;
+    }
+
+    int getMinutes() const {
+        return ((millis() / 1000 + offset) % 3600) / 60;
+    }
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <Arduino.h>
+#include <string>
+#include <vector>
+
+// NVS sobre archivos: cada clave es <directorio>/<namespace>.<clave>.
+// simulatePowerLoss(n) deja pasar n bytes más; la escritura que cruce ese
+// límite queda a medias (bytes nuevos al principio, los viejos después) y
+// todas las siguientes fallan, como si el equipo se hubiera apagado.
+class Preferences {
+private:
+    std::string prefix;
+
+    static std::string& directory() {
+        static std::string path = ".";
+        return path;
+    }
+
+    static long& writeBudget() {
+        static long bytes = -1;  // -1 = sin corte
+        return bytes;
+    }
+
+    std::string path(const char* key) const {
+        return directory() + "/" + prefix + "." + key;
+    }
+
+    std::vector<uint8_t> read(const char* key) const {
+        std::vector<uint8_t> data;
+        FILE* file = fopen(path(key).c_str(), "rb");
+        if (file == nullptr) return data;
+        uint8_t buffer[256];
+        size_t count;
+        while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            data.insert(data.end(), buffer, buffer + count);
+        }
+        fclose(file);
+        return data;
+    }
+
+    void store(const char* key, const std::vector<uint8_t>& data) {
+        FILE* file = fopen(path(key).c_str(), "wb");
+        if (file == nullptr) return;
+        fwrite(data.data(), 1, data.size(), file);
+        fclose(file);
+    }
+
+public:
+    static void setDirectory(const char* path) {
+        directory() = path;
+    }
+
+    static void simulatePowerLoss(long bytesUntilCut) {
+        writeBudget() = bytesUntilCut;
+    }
+
+    static void restorePower() {
+        writeBudget() = -1;
+    }
+
+    bool begin(const char* name, bool readOnly = false) {
+        (void)readOnly;
+        prefix = name;
+        return true;
+    }
+
+    void end() {}
+
+    size_t getBytesLength(const char* key) {
+        return read(key).size();
+    }
+
+    size_t getBytes(const char* key, void* buffer, size_t len) {
+        const std::vector<uint8_t> data = read(key);
+        const size_t count = min(len, data.size());
+        memcpy(buffer, data.data(), count);
+        return count;
+    }
+
+    size_t putBytes(const char* key, const void* value, size_t len) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(value);
+        long& budget = writeBudget();
+        if (budget < 0 || (size_t)budget >= len) {
+            if (budget >= 0) budget -= len;
+            store(key, std::vector<uint8_t>(bytes, bytes + len));
+            return len;
+        }
+
+        // Corte a mitad de la escritura
+        std::vector<uint8_t> torn = read(key);
+        torn.resize(len, 0);
+        memcpy(torn.data(), bytes, budget);
+        store(key, torn);
+        budget = 0;
+        return 0;
+    }
+};
+
+#endif
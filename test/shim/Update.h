@@ -0,0 +1,85 @@
+#ifndef HOST_UPDATE_H
+#define HOST_UPDATE_H
+
+#include <Arduino.h>
+#include <string>
+
+#define UPDATE_SIZE_UNKNOWN 0xFFFFFFFF
+#define U_FLASH 0
+
+// Partición OTA sobre archivos en el directorio de trabajo: write() escribe
+// en ota.inactive y end(true) la renombra a ota.boot, como el cambio de
+// partición de arranque. failWritesAfter(n) hace fallar la escritura que
+// cruce n bytes, como un error de flash.
+class UpdateClass {
+private:
+    FILE* partition = nullptr;
+    size_t written = 0;
+    long writeBudget = -1;  // -1 = sin fallas
+    const char* error = "Sin error";
+
+public:
+    static constexpr const char* INACTIVE_PATH = "ota.inactive";
+    static constexpr const char* BOOT_PATH = "ota.boot";
+
+    bool begin(size_t size = UPDATE_SIZE_UNKNOWN, int command = U_FLASH) {
+        (void)size;
+        (void)command;
+        if (partition != nullptr) {
+            error = "Ya iniciada";
+            return false;
+        }
+        partition = fopen(INACTIVE_PATH, "wb");
+        written = 0;
+        error = "Sin error";
+        return partition != nullptr;
+    }
+
+    size_t write(uint8_t* data, size_t len) {
+        if (partition == nullptr) return 0;
+        if (writeBudget >= 0 && written + len > (size_t)writeBudget) {
+            error = "Error de escritura en flash";
+            return 0;
+        }
+        written += fwrite(data, 1, len, partition);
+        return len;
+    }
+
+    bool end(bool evenIfRemaining = false) {
+        (void)evenIfRemaining;
+        if (partition == nullptr) {
+            error = "No iniciada";
+            return false;
+        }
+        fclose(partition);
+        partition = nullptr;
+        return rename(INACTIVE_PATH, BOOT_PATH) == 0;
+    }
+
+    void abort() {
+        if (partition == nullptr) return;
+        fclose(partition);
+        partition = nullptr;
+        error = "Abortada";
+    }
+
+    bool isRunning() const {
+        return partition != nullptr;
+    }
+
+    const char* errorString() const {
+        return error;
+    }
+
+    size_t progress() const {
+        return written;
+    }
+
+    void failWritesAfter(long bytes) {
+        writeBudget = bytes;
+    }
+};
+
+inline UpdateClass Update;
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef HOST_WIFIUDP_H
+#define HOST_WIFIUDP_H
+
+// Solo el tipo: el reloj del efecto no abre sockets en el host
+class WiFiUDP {};
+
+#endif
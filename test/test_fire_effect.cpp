@@ -0,0 +1,81 @@
+#include "test_support.h"
+#include "effects.h"
+#include "symmetry.h"
+
+// El paso de antes: todo el frame pasa el calor actual a anterior y luego
+// corre el paso normal (que repite la pasada en la región sin cambiar nada)
+class FullPassFire : public FireEffect {
+public:
+    void step(const EffectParams& params) override {
+        for (uint16_t i = 0; i < NUM_LEDS; i++) {
+            firePixels[i] = heat(firePixels[i]) * 0x11;
+        }
+        FireEffect::step(params);
+    }
+};
+
+static EffectParams fireParams(SymmetryMode mode, QualityTier quality) {
+    EffectParams params = {};
+    params.firePalette = 1;
+    params.quality = quality;
+    params.regionWidth = Symmetry::regionWidth(mode);
+    params.regionHeight = Symmetry::regionHeight(mode);
+    return params;
+}
+
+// Un frame replicado por paso, con distintas fases de mezcla entre pasos
+static void renderSequence(FireEffect& fire, const EffectParams& stepParams, SymmetryMode mode,
+                           CRGB (*frames)[NUM_LEDS], uint16_t count) {
+    EffectParams params = stepParams;
+    randomSeed(1234);
+    fire.begin(params);
+    for (uint16_t frame = 0; frame < count; frame++) {
+        fire.step(params);
+        params.stepBlend = (frame * 37) % 257;
+        fill_solid(frames[frame], NUM_LEDS, CRGB::Black);
+        fire.render(frames[frame], params);
+        Symmetry::replicate(frames[frame], mode);
+    }
+}
+
+// Limitar el paso a la región no cambia lo que se ve con ninguna simetría
+// ni calidad
+TEST(mirroredOutputMatchesFullPass) {
+    static const uint16_t FRAMES = 200;
+    static CRGB restricted[FRAMES][NUM_LEDS];
+    static CRGB full[FRAMES][NUM_LEDS];
+    static FireEffect fire;
+    static FullPassFire reference;
+
+    for (uint8_t m = 0; m < SYMMETRY_COUNT; m++) {
+        const SymmetryMode mode = static_cast<SymmetryMode>(m);
+        for (uint8_t q = 0; q < QUALITY_TIER_COUNT; q++) {
+            const EffectParams params = fireParams(mode, static_cast<QualityTier>(q));
+            renderSequence(fire, params, mode, restricted, FRAMES);
+            renderSequence(reference, params, mode, full, FRAMES);
+
+            uint32_t mismatches = 0;
+            for (uint16_t frame = 0; frame < FRAMES; frame++) {
+                if (memcmp(restricted[frame], full[frame], sizeof(full[frame])) != 0) mismatches++;
+            }
+            CHECK_EQ(mismatches, 0);
+        }
+    }
+}
+
+// El fuego sí se mueve: sin esto la comparación anterior pasaría con un
+// frame vacío
+TEST(fireRisesAboveTheBase) {
+    static CRGB frames[50][NUM_LEDS];
+    static FireEffect fire;
+    renderSequence(fire, fireParams(SYMMETRY_NONE, QUALITY_FULL), SYMMETRY_NONE, frames, 50);
+
+    uint16_t lit = 0;
+    for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+        const CRGB& color = frames[49][Matrix::xy(x, 2)];
+        if (color.r || color.g || color.b) lit++;
+    }
+    CHECK(lit > 0);
+}
+
+TEST_MAIN()
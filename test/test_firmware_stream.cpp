@@ -0,0 +1,200 @@
+#include "test_support.h"
+#include "firmware_stream.h"
+#include <chrono>
+#include <vector>
+
+// Imagen de prueba con contenido no trivial
+static std::vector<uint8_t> makeImage(size_t size) {
+    std::vector<uint8_t> image(size);
+    uint32_t state = 12345;
+    for (size_t i = 0; i < size; i++) {
+        state = state * 1103515245 + 12345;
+        image[i] = state >> 16;
+    }
+    return image;
+}
+
+static void sha256(const std::vector<uint8_t>& data, uint8_t* hash) {
+    mbedtls_sha256_context ctx;
+    mbedtls_sha256_init(&ctx);
+    mbedtls_sha256_starts(&ctx, 0);
+    mbedtls_sha256_update(&ctx, data.data(), data.size());
+    mbedtls_sha256_finish(&ctx, hash);
+    mbedtls_sha256_free(&ctx);
+}
+
+static std::vector<uint8_t> readFile(const char* path) {
+    std::vector<uint8_t> data;
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) return data;
+    uint8_t buffer[4096];
+    size_t count;
+    while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + count);
+    }
+    fclose(file);
+    return data;
+}
+
+static bool bootSwitched() {
+    FILE* file = fopen(UpdateClass::BOOT_PATH, "rb");
+    if (file == nullptr) return false;
+    fclose(file);
+    return true;
+}
+
+static void freshPartitions() {
+    remove(UpdateClass::INACTIVE_PATH);
+    remove(UpdateClass::BOOT_PATH);
+    Update.failWritesAfter(-1);
+}
+
+// Bloques del tamaño que entrega el servidor
+static bool streamImage(FirmwareStream& stream, const void* owner, const std::vector<uint8_t>& image,
+                        size_t chunk = 1436) {
+    for (size_t offset = 0; offset < image.size(); offset += chunk) {
+        const size_t len = min(chunk, image.size() - offset);
+        if (!stream.write(owner, image.data() + offset, len)) return false;
+    }
+    return true;
+}
+
+// Vector conocido: SHA-256("abc")
+TEST(shaMatchesReferenceVector) {
+    uint8_t expected[FirmwareStream::HASH_SIZE];
+    CHECK(FirmwareStream::parseHash("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", expected));
+    uint8_t actual[FirmwareStream::HASH_SIZE];
+    const char* abc = "abc";
+    sha256(std::vector<uint8_t>(abc, abc + 3), actual);
+    CHECK(memcmp(actual, expected, sizeof(actual)) == 0);
+}
+
+TEST(parseHashRejectsMalformedInput) {
+    uint8_t hash[FirmwareStream::HASH_SIZE];
+    CHECK(!FirmwareStream::parseHash("", hash));
+    CHECK(!FirmwareStream::parseHash("ba7816bf", hash));
+    CHECK(!FirmwareStream::parseHash("zz7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", hash));
+}
+
+TEST(verifiedImageSwitchesBootPartition) {
+    freshPartitions();
+    const std::vector<uint8_t> image = makeImage(300000);
+    uint8_t hash[FirmwareStream::HASH_SIZE];
+    sha256(image, hash);
+
+    FirmwareStream stream;
+    int owner;
+    CHECK(stream.begin(&owner, hash));
+    CHECK(streamImage(stream, &owner, image));
+    CHECK(stream.finish(&owner));
+    CHECK(!stream.isActive());
+    CHECK_EQ(stream.getReceivedBytes(), image.size());
+    CHECK(bootSwitched());
+    CHECK(readFile(UpdateClass::BOOT_PATH) == image);
+}
+
+TEST(hashMismatchKeepsBootPartition) {
+    freshPartitions();
+    std::vector<uint8_t> image = makeImage(50000);
+    uint8_t hash[FirmwareStream::HASH_SIZE];
+    sha256(image, hash);
+    image[1234] ^= 0x01;  // un bit dañado en el camino
+
+    FirmwareStream stream;
+    int owner;
+    CHECK(stream.begin(&owner, hash));
+    CHECK(streamImage(stream, &owner, image));
+    CHECK(!stream.finish(&owner));
+    CHECK(strcmp(stream.getError(), "SHA-256 no coincide") == 0);
+    CHECK(!stream.isActive());
+    CHECK(!Update.isRunning());
+    CHECK(!bootSwitched());
+}
+
+// Una segunda petición durante la subida: no puede abrir otra sesión y
+// sus bloques no llegan a la partición
+TEST(otherRequestsCannotTouchTheSession) {
+    freshPartitions();
+    const std::vector<uint8_t> image = makeImage(20000);
+    const std::vector<uint8_t> intruder = makeImage(999);
+    uint8_t hash[FirmwareStream::HASH_SIZE];
+    sha256(image, hash);
+
+    FirmwareStream stream;
+    int owner, other;
+    CHECK(stream.begin(&owner, hash));
+    CHECK(!stream.begin(&other, hash));
+    CHECK(strcmp(stream.getError(), "Ya hay una actualización en curso") == 0);
+
+    const size_t half = image.size() / 2;
+    CHECK(stream.write(&owner, image.data(), half));
+    CHECK(!stream.write(&other, intruder.data(), intruder.size()));
+    CHECK(!stream.finish(&other));
+    CHECK(stream.owns(&owner));
+    CHECK(stream.write(&owner, image.data() + half, image.size() - half));
+
+    CHECK(stream.finish(&owner));
+    CHECK(readFile(UpdateClass::BOOT_PATH) == image);
+}
+
+TEST(abortFreesTheSession) {
+    freshPartitions();
+    const std::vector<uint8_t> image = makeImage(10000);
+    uint8_t hash[FirmwareStream::HASH_SIZE];
+    sha256(image, hash);
+
+    FirmwareStream stream;
+    int first, second;
+    CHECK(stream.begin(&first, hash));
+    CHECK(stream.write(&first, image.data(), 4000));
+    stream.abort("Tiempo de espera agotado");
+    CHECK(!stream.isActive());
+    CHECK(!Update.isRunning());
+    CHECK(!stream.write(&first, image.data() + 4000, 1000));
+
+    // El bloque tardío del primero no afecta a la nueva sesión
+    CHECK(stream.begin(&second, hash));
+    CHECK(!stream.write(&first, image.data(), 100));
+    CHECK(streamImage(stream, &second, image));
+    CHECK(stream.finish(&second));
+    CHECK(readFile(UpdateClass::BOOT_PATH) == image);
+}
+
+TEST(flashWriteErrorAbortsTheSession) {
+    freshPartitions();
+    const std::vector<uint8_t> image = makeImage(10000);
+    uint8_t hash[FirmwareStream::HASH_SIZE];
+    sha256(image, hash);
+
+    FirmwareStream stream;
+    int owner;
+    Update.failWritesAfter(5000);
+    CHECK(stream.begin(&owner, hash));
+    CHECK(!streamImage(stream, &owner, image));
+    CHECK(!stream.isActive());
+    CHECK(strcmp(stream.getError(), "Error de escritura en flash") == 0);
+    CHECK(!bootSwitched());
+    Update.failWritesAfter(-1);
+}
+
+// Costo de CPU del hash por bloque, como referencia (no es una prueba de
+// velocidad del enlace)
+TEST(throughputBenchmark) {
+    freshPartitions();
+    const std::vector<uint8_t> image = makeImage(1500000);
+    uint8_t hash[FirmwareStream::HASH_SIZE];
+    sha256(image, hash);
+
+    FirmwareStream stream;
+    int owner;
+    const auto start = std::chrono::steady_clock::now();
+    CHECK(stream.begin(&owner, hash));
+    CHECK(streamImage(stream, &owner, image));
+    CHECK(stream.finish(&owner));
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("     %zu bytes en %.1f ms (%.0f KB/s)\n", image.size(), seconds * 1000,
+           image.size() / 1024.0 / seconds);
+    freshPartitions();
+}
+
+TEST_MAIN()
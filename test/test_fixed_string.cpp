@@ -0,0 +1,137 @@
+#include "test_support.h"
+#include "fixed_string.h"
+#include "text_scroller.h"
+#include <new>
+#include <string>
+
+// Contador de memoria dinámica: cada new/delete del programa pasa por aquí.
+// En estado estable el render, la web y el versículo no deben pedir nada.
+namespace HeapCounter {
+    size_t allocations = 0;
+    long liveBytes = 0;
+}
+
+void* operator new(size_t size) {
+    HeapCounter::allocations++;
+    HeapCounter::liveBytes += size;
+    size_t* block = static_cast<size_t*>(malloc(size + sizeof(size_t)));
+    if (block == nullptr) throw std::bad_alloc();
+    *block = size;
+    return block + 1;
+}
+
+void operator delete(void* pointer) noexcept {
+    if (pointer == nullptr) return;
+    size_t* block = static_cast<size_t*>(pointer) - 1;
+    HeapCounter::liveBytes -= *block;
+    free(block);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    operator delete(pointer);
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete[](void* pointer) noexcept {
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    operator delete(pointer);
+}
+
+static const char* VERSES[] = {
+    "Porque de tal manera amó Dios al mundo, que ha dado a su Hijo unigénito",
+    "El Señor es mi pastor; nada me faltará.",
+    "Lámpara es a mis pies tu palabra, y lumbrera a mi camino.",
+};
+
+// Lo que hace cada frame el render con texto: reloj, referencia y el
+// versículo que se desplaza
+static void renderFrame(TextScroller& scroller, uint32_t frame, uint8_t (*alpha)[Matrix::WIDTH]) {
+    FixedString<8> timeStr;
+    timeStr.appendf("%02u:%02u", (unsigned)(frame / 60 % 24), (unsigned)(frame % 60));
+    FixedString<12> passageStr;
+    passageStr.appendf("%u:%u:%u", 43u, 3u, (unsigned)(frame % 40));
+    scroller.applyPending();
+    scroller.advance();
+    scroller.blit(alpha);
+}
+
+// Lo que hace la web al pedir el versículo: URL de traducción con el texto
+// codificado y la referencia formateada
+static void verseRequest(uint32_t round, FixedString<TRANSLATE_URL_CAPACITY>& request,
+                         FixedString<VERSE_TEXT_CAPACITY>& cachedVerse,
+                         FixedString<VERSE_REFERENCE_CAPACITY>& cachedReference) {
+    const char* text = VERSES[round % 3];
+    request.clear();
+    request.append("https://translate.example/?sl=en&tl=es&q=").appendUrlEncoded(text);
+    cachedVerse = text;
+    cachedReference.clear();
+    cachedReference.appendf("%s %u:%u", "Juan", 3u, (unsigned)(round % 40));
+}
+
+TEST(counterSeesStringChurn) {
+    const size_t before = HeapCounter::allocations;
+    std::string churn;
+    for (int i = 0; i < 100; i++) churn += "verso ";
+    CHECK(HeapCounter::allocations > before);
+}
+
+TEST(truncatesInsteadOfGrowing) {
+    FixedString<8> text;
+    text.append("1234").appendf("%d", 567890);
+    CHECK(text.isTruncated());
+    CHECK_EQ(text.length(), 8);
+    CHECK(text == "12345678");
+
+    FixedString<5> encoded;
+    encoded.appendUrlEncoded("a b?c");
+    CHECK(encoded == "a+b");
+    CHECK(encoded.isTruncated());
+}
+
+TEST(urlEncodingMatchesForm) {
+    FixedString<64> encoded;
+    encoded.appendUrlEncoded("Dios amó al mundo, 3:16");
+    CHECK(encoded == "Dios+am%C3%B3+al+mundo%2C+3%3A16");
+    CHECK(!encoded.isTruncated());
+}
+
+// Una hora de frames con el versículo cambiando cada minuto y la web
+// pidiendo la traducción: ninguna reserva ni bytes retenidos de más
+TEST(steadyStateDoesNotAllocate) {
+    static TextScroller scroller;
+    static FixedString<TRANSLATE_URL_CAPACITY> request;
+    static FixedString<VERSE_TEXT_CAPACITY> cachedVerse;
+    static FixedString<VERSE_REFERENCE_CAPACITY> cachedReference;
+    static uint8_t alpha[Font::ROWS][Matrix::WIDTH];
+
+    // Calentamiento: primer texto y primer frame
+    verseRequest(0, request, cachedVerse, cachedReference);
+    scroller.setText(cachedVerse.c_str());
+    renderFrame(scroller, 0, alpha);
+
+    const size_t allocationsBefore = HeapCounter::allocations;
+    const long liveBefore = HeapCounter::liveBytes;
+
+    const uint32_t framesPerMinute = 60000000 / FRAME_INTERVAL_US;
+    const uint32_t frames = framesPerMinute * 60;
+    for (uint32_t frame = 1; frame < frames; frame++) {
+        if (frame % framesPerMinute == 0) {
+            verseRequest(frame / framesPerMinute, request, cachedVerse, cachedReference);
+            scroller.setText(cachedVerse.c_str());
+        }
+        renderFrame(scroller, frame, alpha);
+    }
+
+    CHECK_EQ(HeapCounter::allocations - allocationsBefore, 0);
+    CHECK_EQ(HeapCounter::liveBytes - liveBefore, 0);
+    CHECK_EQ(scroller.getRasterizations(), 60);
+    CHECK(!scroller.isTruncated());
+}
+
+TEST_MAIN()
@@ -0,0 +1,164 @@
+#include "test_support.h"
+#include "frame_metrics.h"
+#include <string>
+
+// Salida de printFields() capturada en memoria
+class StringPrint : public Print {
+public:
+    std::string text;
+
+    size_t write(const uint8_t* data, size_t len) override {
+        text.append(reinterpret_cast<const char*>(data), len);
+        return len;
+    }
+};
+
+// Un frame con la duración de cada etapa en us; el contador de ciclos
+// avanza con el reloj falso. Devuelve lo que record() reporta al gobernador
+static uint32_t recordFrame(FrameMetrics& metrics, uint8_t slot, uint32_t drain, uint32_t effect,
+                            uint32_t post, uint32_t show) {
+    const uint32_t durations[STAGE_TOTAL] = {drain, effect, post, show};
+    uint32_t marks[STAGE_TOTAL + 1];
+    for (uint8_t s = 0; s < STAGE_TOTAL; s++) {
+        marks[s] = FrameMetrics::now();
+        HostClock::advanceMicros(durations[s]);
+    }
+    marks[STAGE_TOTAL] = FrameMetrics::now();
+    return metrics.record(slot, marks);
+}
+
+// Con un solo valor más uno enorme, el p50 es el límite de la cubeta del valor
+static uint32_t reportedLimit(uint32_t micros) {
+    StageHistogram histogram;
+    histogram.record(micros);
+    histogram.record(1000000);
+    return histogram.percentile(50);
+}
+
+// Medias octavas desde 32 us; todo lo menor a 48 va a la primera cubeta y
+// lo mayor a ~65 ms a la última
+TEST(bucketBoundsAreHalfOctaves) {
+    CHECK_EQ(reportedLimit(0), 48);
+    CHECK_EQ(reportedLimit(31), 48);
+    CHECK_EQ(reportedLimit(47), 48);
+    CHECK_EQ(reportedLimit(48), 64);
+    CHECK_EQ(reportedLimit(63), 64);
+    CHECK_EQ(reportedLimit(64), 96);
+    CHECK_EQ(reportedLimit(95), 96);
+    CHECK_EQ(reportedLimit(96), 128);
+    CHECK_EQ(reportedLimit(767), 768);
+    CHECK_EQ(reportedLimit(768), 1024);
+    CHECK_EQ(reportedLimit(1000), 1024);
+    CHECK_EQ(reportedLimit(65535), 65536);
+    CHECK_EQ(reportedLimit(500000), 65536);
+}
+
+TEST(percentilesRoundUpToBucketButNotPastMax) {
+    StageHistogram histogram;
+    CHECK_EQ(histogram.percentile(50), 0);
+
+    for (uint8_t i = 0; i < 98; i++) histogram.record(40);
+    histogram.record(700);
+    histogram.record(700);
+    CHECK_EQ(histogram.percentile(50), 48);
+    CHECK_EQ(histogram.percentile(98), 48);
+    // La cubeta de 700 llega a 768, pero nada pasó de 700
+    CHECK_EQ(histogram.percentile(99), 700);
+    CHECK_EQ(histogram.getMax(), 700);
+
+    histogram.record(5000);
+    CHECK_EQ(histogram.percentile(99), 768);
+    CHECK_EQ(histogram.percentile(100), 5000);
+    CHECK_EQ(histogram.getMax(), 5000);
+}
+
+// Al llegar una cubeta a 65535 todas se dividen entre dos: las proporciones
+// (y los percentiles) se conservan en lugar de desbordar
+TEST(saturatedCountersHalveAndKeepProportions) {
+    StageHistogram histogram;
+    for (uint32_t i = 0; i < UINT16_MAX; i++) histogram.record(40);
+    for (uint32_t i = 0; i < 20000; i++) histogram.record(700);
+    CHECK_EQ(histogram.percentile(76), 48);
+    CHECK_EQ(histogram.percentile(77), 700);
+
+    histogram.record(40);
+    CHECK_EQ(histogram.percentile(50), 48);
+    CHECK_EQ(histogram.percentile(76), 48);
+    CHECK_EQ(histogram.percentile(77), 700);
+}
+
+TEST(framesAreAttributedToTheirEffect) {
+    FrameMetrics metrics;
+    metrics.begin();
+
+    recordFrame(metrics, FIRE, 10, 400, 100, 5);
+    recordFrame(metrics, FIRE, 10, 500, 100, 5);
+    recordFrame(metrics, FrameMetrics::TRANSITION, 10, 900, 100, 5);
+    recordFrame(metrics, RAINBOW, 10, 200, 100, 5);
+
+    CHECK_EQ(metrics.get(FIRE).frames, 2);
+    CHECK_EQ(metrics.get(FrameMetrics::TRANSITION).frames, 1);
+    CHECK_EQ(metrics.get(RAINBOW).frames, 1);
+    CHECK_EQ(metrics.get(LIFE).frames, 0);
+
+    CHECK_EQ(metrics.get(FIRE).stages[STAGE_EFFECT].getMax(), 500);
+    CHECK_EQ(metrics.get(FIRE).stages[STAGE_TOTAL].getMax(), 615);
+    CHECK_EQ(metrics.get(FrameMetrics::TRANSITION).stages[STAGE_EFFECT].getMax(), 900);
+    CHECK_EQ(metrics.get(RAINBOW).stages[STAGE_POST].getMax(), 100);
+
+    // Solo se listan los que tuvieron frames
+    StringPrint out;
+    metrics.printFields(out);
+    CHECK(out.text.find("\"fire\":{\"frames\":2") != std::string::npos);
+    CHECK(out.text.find("\"transition\":{\"frames\":1") != std::string::npos);
+    CHECK(out.text.find("\"life\"") == std::string::npos);
+    CHECK(strcmp(FrameMetrics::slotName(FrameMetrics::TRANSITION), "transition") == 0);
+}
+
+TEST(unknownSlotsCountAsOff) {
+    FrameMetrics metrics;
+    metrics.begin();
+    recordFrame(metrics, FrameMetrics::SLOT_COUNT + 3, 10, 10, 10, 10);
+    CHECK_EQ(metrics.get(OFF).frames, 1);
+}
+
+// El plazo se compara con el frame completo, entrega incluida; justo en el
+// plazo no es atraso
+TEST(deadlineMissesCountWholeFrames) {
+    FrameMetrics metrics;
+    metrics.begin();
+
+    const uint32_t third = FRAME_DEADLINE_US / 3;
+    const uint32_t onTime = recordFrame(metrics, FIRE, 0, third, third, FRAME_DEADLINE_US - third * 2);
+    CHECK_EQ(onTime, FRAME_DEADLINE_US);
+    CHECK_EQ(metrics.get(FIRE).deadlineMisses, 0);
+
+    const uint32_t late = recordFrame(metrics, FIRE, 0, third, third, FRAME_DEADLINE_US - third * 2 + 1);
+    CHECK_EQ(late, FRAME_DEADLINE_US + 1);
+    CHECK_EQ(metrics.get(FIRE).deadlineMisses, 1);
+
+    recordFrame(metrics, FrameMetrics::TRANSITION, 0, FRAME_DEADLINE_US, 1, 0);
+    CHECK_EQ(metrics.get(FrameMetrics::TRANSITION).deadlineMisses, 1);
+    CHECK_EQ(metrics.get(FIRE).deadlineMisses, 1);
+}
+
+// El reinicio pedido se aplica en el siguiente frame y limpia todas las ranuras
+TEST(resetClearsEverySlotAtNextFrame) {
+    FrameMetrics metrics;
+    metrics.begin();
+    recordFrame(metrics, FIRE, 10, FRAME_DEADLINE_US, 10, 10);
+    recordFrame(metrics, FrameMetrics::TRANSITION, 10, 300, 10, 10);
+
+    metrics.requestReset();
+    CHECK_EQ(metrics.get(FIRE).frames, 1);
+
+    recordFrame(metrics, RAINBOW, 10, 50, 10, 10);
+    CHECK_EQ(metrics.get(FIRE).frames, 0);
+    CHECK_EQ(metrics.get(FIRE).deadlineMisses, 0);
+    CHECK_EQ(metrics.get(FIRE).stages[STAGE_EFFECT].getMax(), 0);
+    CHECK_EQ(metrics.get(FIRE).stages[STAGE_EFFECT].percentile(50), 0);
+    CHECK_EQ(metrics.get(FrameMetrics::TRANSITION).frames, 0);
+    CHECK_EQ(metrics.get(RAINBOW).frames, 1);
+}
+
+TEST_MAIN()
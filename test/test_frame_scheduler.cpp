@@ -0,0 +1,232 @@
+#include "test_support.h"
+#include "frame_scheduler.h"
+
+// Reloj falso: cada prueba decide exactamente cuándo llega cada vuelta del
+// render, así que los resultados no dependen de la máquina
+
+TEST(framesFollowTheGrid) {
+    FrameScheduler scheduler;
+    CHECK(scheduler.frameDue(1000));
+    CHECK(!scheduler.frameDue(1000 + FRAME_INTERVAL_US - 1));
+
+    // Llegar tarde no corre la rejilla: el siguiente sigue en 1000 + 2 intervalos
+    CHECK(scheduler.frameDue(1000 + FRAME_INTERVAL_US + 5000));
+    CHECK(!scheduler.frameDue(1000 + FRAME_INTERVAL_US * 2 - 1));
+    CHECK(scheduler.frameDue(1000 + FRAME_INTERVAL_US * 2));
+
+    const FrameScheduler::Stats& stats = scheduler.getStats();
+    CHECK_EQ(stats.frames, 3);
+    CHECK_EQ(stats.skippedFrames, 0);
+    CHECK_EQ(stats.maxJitterMicros, 5000);
+}
+
+// Un atraso menor que MAX_FRAME_LAG frames se recupera encadenando frames
+TEST(smallLagCatchesUp) {
+    FrameScheduler scheduler;
+    CHECK(scheduler.frameDue(0));
+    const uint32_t now = FRAME_INTERVAL_US * (MAX_FRAME_LAG - 1) + FRAME_INTERVAL_US / 2;
+    uint8_t frames = 0;
+    while (scheduler.frameDue(now)) frames++;
+    CHECK_EQ(frames, MAX_FRAME_LAG - 1);
+    CHECK_EQ(scheduler.getStats().skippedFrames, 0);
+}
+
+// Tras una pausa larga los frames perdidos se saltan y la rejilla se
+// reinicia desde ahora, en lugar de dibujar una ráfaga
+TEST(longStallSkipsFramesInsteadOfBursting) {
+    FrameScheduler scheduler;
+    CHECK(scheduler.frameDue(0));
+    const uint32_t stall = FRAME_INTERVAL_US * 10 + 300;
+    CHECK(scheduler.frameDue(stall));
+    CHECK(!scheduler.frameDue(stall + FRAME_INTERVAL_US - 1));
+    CHECK(scheduler.frameDue(stall + FRAME_INTERVAL_US));
+    // Se perdieron los frames de 1 a 9 intervalos; el de 10 se dibuja tarde
+    CHECK_EQ(scheduler.getStats().skippedFrames, 9);
+}
+
+TEST(stepsFollowElapsedTime) {
+    FrameScheduler scheduler;
+    const uint32_t stepInterval = 10000;
+    scheduler.frameDue(0);
+    CHECK_EQ(scheduler.stepsDue(0, stepInterval), 0);
+
+    // 22 ms acumulados: dos pasos y sobran 2 ms
+    scheduler.frameDue(FRAME_INTERVAL_US);
+    CHECK_EQ(scheduler.stepsDue(0, stepInterval), FRAME_INTERVAL_US / stepInterval);
+    CHECK_EQ(scheduler.stepBlend(0, stepInterval), (FRAME_INTERVAL_US % stepInterval) * 256 / stepInterval);
+
+    // A lo largo de un segundo se da exactamente un paso por intervalo
+    uint32_t steps = FRAME_INTERVAL_US / stepInterval;
+    for (uint32_t now = FRAME_INTERVAL_US * 2; now <= 1000000 + FRAME_INTERVAL_US; now += FRAME_INTERVAL_US) {
+        CHECK(scheduler.frameDue(now));
+        steps += scheduler.stepsDue(0, stepInterval);
+    }
+    const uint32_t elapsed = (1000000 / FRAME_INTERVAL_US + 1) * FRAME_INTERVAL_US;
+    CHECK_EQ(steps, elapsed / stepInterval);
+    CHECK_EQ(scheduler.getStats().droppedSteps, 0);
+}
+
+// Blend entre los dos últimos estados: crece con el tiempo dentro del paso
+TEST(blendTracksFractionOfStep) {
+    FrameScheduler scheduler;
+    const uint32_t stepInterval = FRAME_INTERVAL_US * 4;
+    scheduler.frameDue(0);
+    uint16_t expected[] = {64, 128, 192};
+    for (uint8_t i = 0; i < 3; i++) {
+        scheduler.frameDue(FRAME_INTERVAL_US * (i + 1));
+        CHECK_EQ(scheduler.stepsDue(0, stepInterval), 0);
+        CHECK_EQ(scheduler.stepBlend(0, stepInterval), expected[i]);
+    }
+    scheduler.frameDue(FRAME_INTERVAL_US * 4);
+    CHECK_EQ(scheduler.stepsDue(0, stepInterval), 1);
+    CHECK_EQ(scheduler.stepBlend(0, stepInterval), 0);
+}
+
+// Un efecto más rápido de lo que el frame permite: MAX_STEPS_PER_FRAME
+// pasos y el resto se descarta (entero), conservando la fracción
+TEST(overloadDropsStepsButKeepsFraction) {
+    FrameScheduler scheduler;
+    const uint32_t stepInterval = 1500;
+    scheduler.frameDue(0);
+    scheduler.frameDue(FRAME_INTERVAL_US);
+    CHECK_EQ(scheduler.stepsDue(0, stepInterval), MAX_STEPS_PER_FRAME);
+
+    const uint32_t remaining = FRAME_INTERVAL_US - MAX_STEPS_PER_FRAME * stepInterval;
+    CHECK_EQ(scheduler.getStats().droppedSteps, remaining / stepInterval);
+    CHECK_EQ(scheduler.stepBlend(0, stepInterval), (remaining % stepInterval) * 256 / stepInterval);
+}
+
+TEST(pausedEffectShowsCurrentState) {
+    FrameScheduler scheduler;
+    scheduler.frameDue(0);
+    scheduler.frameDue(FRAME_INTERVAL_US);
+    CHECK_EQ(scheduler.stepsDue(0, 0), 0);
+    CHECK_EQ(scheduler.stepBlend(0, 0), 256);
+
+    // Al reanudar no arrastra el tiempo en pausa
+    scheduler.frameDue(FRAME_INTERVAL_US * 2);
+    CHECK_EQ(scheduler.stepsDue(0, FRAME_INTERVAL_US), 1);
+}
+
+TEST(slotsAccumulateIndependently) {
+    FrameScheduler scheduler;
+    scheduler.frameDue(0);
+    scheduler.frameDue(FRAME_INTERVAL_US);
+    scheduler.resetSimulation(1);
+    CHECK_EQ(scheduler.stepsDue(0, FRAME_INTERVAL_US), 1);
+    CHECK_EQ(scheduler.stepsDue(1, FRAME_INTERVAL_US), 0);
+
+    scheduler.frameDue(FRAME_INTERVAL_US * 2);
+    CHECK_EQ(scheduler.stepsDue(1, FRAME_INTERVAL_US), 1);
+    CHECK_EQ(scheduler.stepsDue(FrameScheduler::SLOTS - 1, FRAME_INTERVAL_US), 2);
+}
+
+TEST(resetClearsStatsOnNextFrame) {
+    FrameScheduler scheduler;
+    scheduler.frameDue(0);
+    scheduler.frameDue(FRAME_INTERVAL_US * 10);
+    CHECK(scheduler.getStats().skippedFrames > 0);
+
+    scheduler.requestReset();
+    CHECK(scheduler.getStats().skippedFrames > 0);
+    scheduler.frameDue(FRAME_INTERVAL_US * 11);
+    CHECK_EQ(scheduler.getStats().skippedFrames, 0);
+    CHECK_EQ(scheduler.getStats().frames, 1);
+}
+
+// Gobernador de calidad con costos inyectados. El costo es el del render;
+// el envío a los LEDs corre en paralelo en la tarea de salida
+static void feedWindow(FrameScheduler& scheduler, uint8_t misses, uint8_t tiers = QUALITY_TIER_COUNT) {
+    for (uint8_t i = 0; i < QUALITY_WINDOW; i++) {
+        scheduler.recordFrameCost(i < misses ? FRAME_DEADLINE_US + 1 : FRAME_DEADLINE_US, tiers);
+    }
+}
+
+TEST(deadlineLeavesRoomForShow) {
+    CHECK(LED_WIRE_US < FRAME_INTERVAL_US);
+    CHECK(FRAME_DEADLINE_US > 0 && FRAME_DEADLINE_US < FRAME_INTERVAL_US);
+}
+
+// El caso más caro del ejemplo de /api/metrics del README: una transición
+// (dos fuegos al p99 de 512 us y la mezcla), dos capas de fuego, post FX
+// en su pico de 655 us; la mezcla, el texto y la conversión son
+// estimados. Tiene que quedar en calidad completa con holgura.
+TEST(heaviestDocumentedFrameKeepsFullQuality) {
+    const uint32_t cost = 512 * 2 + 200 + 512 * 2 + 655 + 300 + 500;
+    CHECK(cost * 2 < FRAME_DEADLINE_US);
+
+    FrameScheduler scheduler;
+    for (uint16_t i = 0; i < QUALITY_WINDOW * 20; i++) {
+        scheduler.recordFrameCost(cost, QUALITY_TIER_COUNT);
+    }
+    CHECK_EQ(scheduler.getQuality(), QUALITY_FULL);
+    CHECK_EQ(scheduler.getStats().qualityDrops, 0);
+}
+
+TEST(costsWithinBudgetKeepFullQuality) {
+    FrameScheduler scheduler;
+    for (uint8_t window = 0; window < 20; window++) {
+        feedWindow(scheduler, QUALITY_MISS_LIMIT - 1);
+    }
+    CHECK_EQ(scheduler.getQuality(), QUALITY_FULL);
+    CHECK_EQ(scheduler.getStats().qualityDrops, 0);
+}
+
+TEST(repeatedMissesDropQualityAtWindowEnd) {
+    FrameScheduler scheduler;
+    for (uint8_t i = 0; i < QUALITY_WINDOW - 1; i++) {
+        scheduler.recordFrameCost(FRAME_DEADLINE_US * 2, QUALITY_TIER_COUNT);
+    }
+    CHECK_EQ(scheduler.getQuality(), QUALITY_FULL);
+    scheduler.recordFrameCost(FRAME_DEADLINE_US * 2, QUALITY_TIER_COUNT);
+    CHECK_EQ(scheduler.getQuality(), QUALITY_REDUCED);
+    CHECK_EQ(scheduler.getStats().qualityDrops, 1);
+
+    // Ya en el nivel más bajo no hay más bajadas
+    feedWindow(scheduler, QUALITY_WINDOW);
+    CHECK_EQ(scheduler.getQuality(), QUALITY_REDUCED);
+    CHECK_EQ(scheduler.getStats().qualityDrops, 1);
+}
+
+TEST(singleTierEffectsNeverDrop) {
+    FrameScheduler scheduler;
+    feedWindow(scheduler, QUALITY_WINDOW, 1);
+    CHECK_EQ(scheduler.getQuality(), QUALITY_FULL);
+}
+
+TEST(qualityRecoversAfterCleanWindows) {
+    FrameScheduler scheduler;
+    feedWindow(scheduler, QUALITY_MISS_LIMIT);
+    CHECK_EQ(scheduler.getQuality(), QUALITY_REDUCED);
+
+    for (uint8_t window = 0; window < QUALITY_RECOVERY_WINDOWS - 1; window++) {
+        feedWindow(scheduler, 0);
+    }
+    CHECK_EQ(scheduler.getQuality(), QUALITY_REDUCED);
+
+    // Una ventana con un atraso reinicia la cuenta de ventanas limpias
+    feedWindow(scheduler, 1);
+    feedWindow(scheduler, 0);
+    CHECK_EQ(scheduler.getQuality(), QUALITY_REDUCED);
+    for (uint8_t window = 0; window < QUALITY_RECOVERY_WINDOWS - 1; window++) {
+        feedWindow(scheduler, 0);
+    }
+    CHECK_EQ(scheduler.getQuality(), QUALITY_FULL);
+    CHECK_EQ(scheduler.getStats().qualityRaises, 1);
+}
+
+TEST(resetQualityStartsFresh) {
+    FrameScheduler scheduler;
+    feedWindow(scheduler, QUALITY_WINDOW);
+    CHECK_EQ(scheduler.getQuality(), QUALITY_REDUCED);
+    scheduler.resetQuality();
+    CHECK_EQ(scheduler.getQuality(), QUALITY_FULL);
+
+    // La ventana empieza de cero: medio ventana de atrasos no basta
+    for (uint8_t i = 0; i < QUALITY_WINDOW / 2; i++) {
+        scheduler.recordFrameCost(FRAME_DEADLINE_US * 2, QUALITY_TIER_COUNT);
+    }
+    CHECK_EQ(scheduler.getQuality(), QUALITY_FULL);
+}
+
+TEST_MAIN()
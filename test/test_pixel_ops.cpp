@@ -0,0 +1,131 @@
+#include "test_support.h"
+#include "config.h"
+#include "pixel_ops.h"
+#include <chrono>
+
+// Mezcla de referencia de un byte
+static uint8_t referenceLerp(uint8_t a, uint8_t b, uint16_t t) {
+    return (a * (256 - t) + b * t) >> 8;
+}
+
+static uint32_t referenceLerp8x4(uint32_t a, uint32_t b, uint16_t t) {
+    uint32_t result = 0;
+    for (uint8_t lane = 0; lane < 32; lane += 8) {
+        result |= (uint32_t)referenceLerp(a >> lane, b >> lane, t) << lane;
+    }
+    return result;
+}
+
+static uint32_t nextRandom(uint32_t& seed) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+TEST(lerpEndpointsAreExact) {
+    uint32_t seed = 1;
+    for (uint16_t i = 0; i < 1000; i++) {
+        const uint32_t a = nextRandom(seed);
+        const uint32_t b = nextRandom(seed);
+        CHECK_EQ(PixelOps::lerp8x4(a, b, 0), a);
+        CHECK_EQ(PixelOps::lerp8x4(a, b, 256), b);
+    }
+}
+
+// Carriles en 255 junto a carriles en 0: si una suma pasara a su vecino,
+// los carriles en 0 dejarían de serlo
+TEST(lanesDoNotCarry) {
+    const uint32_t patterns[][2] = {
+        {0xFFFFFFFF, 0xFFFFFFFF},
+        {0xFFFFFFFF, 0x00000000},
+        {0x00FF00FF, 0xFF00FF00},
+        {0xFF00FF00, 0x00FF00FF},
+        {0x00FF00FF, 0x00FF00FF},
+        {0xFF00FF00, 0xFF00FF00},
+    };
+    for (const auto& pattern : patterns) {
+        for (uint16_t t = 0; t <= 256; t++) {
+            CHECK_EQ(PixelOps::lerp8x4(pattern[0], pattern[1], t), referenceLerp8x4(pattern[0], pattern[1], t));
+        }
+    }
+    for (uint16_t t = 0; t <= 256; t++) {
+        CHECK_EQ(PixelOps::lerp8x4(0xFF00FF00, 0xFF00FF00, t) & 0x00FF00FF, 0);
+        CHECK_EQ(PixelOps::lerp8x4(0x00FF00FF, 0x00FF00FF, t) & 0xFF00FF00, 0);
+    }
+}
+
+TEST(lerpMatchesBytewiseReference) {
+    uint32_t seed = 7;
+    for (uint16_t t = 0; t <= 256; t++) {
+        for (uint8_t i = 0; i < 50; i++) {
+            const uint32_t a = nextRandom(seed);
+            const uint32_t b = nextRandom(seed);
+            CHECK_EQ(PixelOps::lerp8x4(a, b, t), referenceLerp8x4(a, b, t));
+        }
+    }
+}
+
+// Con 5 pixeles quedan 3 bytes fuera de las palabras completas
+TEST(lerpPixelsCoversTheTail) {
+    alignas(4) CRGB dst[5];
+    alignas(4) CRGB from[5];
+    uint32_t seed = 99;
+    for (uint16_t t : {0, 1, 77, 128, 255, 256}) {
+        uint8_t expected[sizeof(dst)];
+        for (uint8_t i = 0; i < 5; i++) {
+            dst[i] = CRGB(nextRandom(seed), nextRandom(seed), nextRandom(seed));
+            from[i] = CRGB(nextRandom(seed), nextRandom(seed), nextRandom(seed));
+        }
+        const uint8_t* in = reinterpret_cast<const uint8_t*>(from);
+        const uint8_t* out = reinterpret_cast<const uint8_t*>(dst);
+        for (uint8_t i = 0; i < sizeof(dst); i++) {
+            expected[i] = referenceLerp(in[i], out[i], t);
+        }
+        PixelOps::lerpPixels(dst, from, 5, t);
+        CHECK(memcmp(dst, expected, sizeof(dst)) == 0);
+    }
+}
+
+TEST(packRoundTrips) {
+    const CRGB color(12, 200, 255);
+    CHECK_EQ(PixelOps::pack(color), 0x0CC8FF);
+    CHECK(PixelOps::unpack(PixelOps::pack(color)) == color);
+    CHECK_EQ(PixelOps::pack(1, 2, 3), 0x010203);
+}
+
+// Costo de lerpPixels() sobre un frame contra la mezcla byte por byte
+TEST(lerpPixelsBenchmark) {
+    static const uint32_t FRAMES = 20000;
+    alignas(4) static CRGB dst[NUM_LEDS];
+    alignas(4) static CRGB plain[NUM_LEDS];
+    alignas(4) static CRGB from[NUM_LEDS];
+    uint32_t seed = 3;
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        from[i] = CRGB(nextRandom(seed), nextRandom(seed), nextRandom(seed));
+        dst[i] = plain[i] = CRGB(nextRandom(seed), nextRandom(seed), nextRandom(seed));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < FRAMES; frame++) {
+        PixelOps::lerpPixels(dst, from, NUM_LEDS, frame % 257);
+    }
+    const double wordSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(from);
+    uint8_t* out = reinterpret_cast<uint8_t*>(plain);
+    start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < FRAMES; frame++) {
+        const uint16_t t = frame % 257;
+        for (uint16_t i = 0; i < NUM_LEDS * 3; i++) {
+            out[i] = referenceLerp(in[i], out[i], t);
+        }
+    }
+    const double byteSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    CHECK(memcmp(dst, plain, sizeof(plain)) == 0);
+    printf("     lerpPixels: %.2f us/frame, byte por byte: %.2f us/frame (%.2fx)\n",
+           wordSeconds * 1e6 / FRAMES, byteSeconds * 1e6 / FRAMES, byteSeconds / wordSeconds);
+}
+
+TEST_MAIN()
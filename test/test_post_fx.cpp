@@ -0,0 +1,236 @@
+#include "test_support.h"
+#include "post_fx.h"
+#include <chrono>
+
+// Frame en orden x + y * WIDTH, independiente del cableado en serpentina
+struct Grid {
+    CRGB pixels[NUM_LEDS];
+
+    CRGB& at(uint8_t x, uint8_t y) {
+        return pixels[y * Matrix::WIDTH + x];
+    }
+};
+
+static void toLeds(Grid& grid, CRGB* leds) {
+    for (uint8_t y = 0; y < Matrix::HEIGHT; y++) {
+        for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+            leds[Matrix::xy(x, y)] = grid.at(x, y);
+        }
+    }
+}
+
+static void fromLeds(const CRGB* leds, Grid& grid) {
+    for (uint8_t y = 0; y < Matrix::HEIGHT; y++) {
+        for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+            grid.at(x, y) = leds[Matrix::xy(x, y)];
+        }
+    }
+}
+
+static void randomGrid(Grid& grid, uint32_t seed) {
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        seed = seed * 1103515245 + 12345;
+        grid.pixels[i] = CRGB(seed >> 24, seed >> 16, seed >> 8);
+    }
+}
+
+// Caja de referencia canal por canal: suma directa de la ventana (sin suma
+// corrida), bordes repetidos, filas que dan la vuelta en el anillo y la
+// misma división en punto fijo que PostFx
+static void referenceBox(Grid& grid, uint8_t radius) {
+    const uint8_t taps = radius * 2 + 1;
+    const uint32_t inverse = (65536 + taps - 1) / taps;
+    Grid rows;
+
+    for (uint8_t y = 0; y < Matrix::HEIGHT; y++) {
+        for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+            for (uint8_t c = 0; c < 3; c++) {
+                uint32_t sum = 0;
+                for (int16_t dx = -radius; dx <= radius; dx++) {
+                    int16_t sx = x + dx;
+                    if (Matrix::RING) {
+                        sx = (sx + Matrix::WIDTH) % Matrix::WIDTH;
+                    } else {
+                        sx = constrain(sx, 0, Matrix::WIDTH - 1);
+                    }
+                    sum += grid.at(sx, y).raw[c];
+                }
+                rows.at(x, y).raw[c] = (sum * inverse) >> 16;
+            }
+        }
+    }
+
+    for (uint8_t y = 0; y < Matrix::HEIGHT; y++) {
+        for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+            for (uint8_t c = 0; c < 3; c++) {
+                uint32_t sum = 0;
+                for (int16_t dy = -radius; dy <= radius; dy++) {
+                    const int16_t sy = constrain(y + dy, 0, Matrix::HEIGHT - 1);
+                    sum += rows.at(x, sy).raw[c];
+                }
+                grid.at(x, y).raw[c] = (sum * inverse) >> 16;
+            }
+        }
+    }
+}
+
+static uint32_t countMismatches(Grid& actual, Grid& expected) {
+    uint32_t mismatches = 0;
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        if (!(actual.pixels[i] == expected.pixels[i])) mismatches++;
+    }
+    return mismatches;
+}
+
+// Aplica el modo a grid y devuelve el resultado en orden x + y * WIDTH
+static void applyTo(PostFx& fx, Grid& grid, const PostFxSettings& settings) {
+    static CRGB leds[NUM_LEDS];
+    toLeds(grid, leds);
+    fx.apply(leds, settings);
+    fromLeds(leds, grid);
+}
+
+TEST(boxMatchesReference) {
+    static PostFx fx;
+    for (uint8_t radius = 1; radius <= MAX_BLUR_RADIUS; radius++) {
+        for (uint32_t seed = 1; seed <= 5; seed++) {
+            static Grid actual, expected;
+            randomGrid(actual, seed * 31 + radius);
+            expected = actual;
+            applyTo(fx, actual, {POSTFX_BOX, radius, 0});
+            referenceBox(expected, radius);
+            CHECK_EQ(countMismatches(actual, expected), 0);
+        }
+    }
+}
+
+TEST(gaussianIsTwoBoxPasses) {
+    static PostFx fx;
+    for (uint8_t radius = 1; radius <= MAX_BLUR_RADIUS; radius++) {
+        static Grid actual, expected;
+        randomGrid(actual, 500 + radius);
+        expected = actual;
+        applyTo(fx, actual, {POSTFX_GAUSSIAN, radius, 0});
+        referenceBox(expected, radius);
+        referenceBox(expected, radius);
+        CHECK_EQ(countMismatches(actual, expected), 0);
+    }
+}
+
+// El resplandor desenfoca solo lo que pasa del umbral y lo suma saturando
+TEST(bloomAddsBlurredExcess) {
+    static PostFx fx;
+    const uint8_t threshold = 150;
+    for (uint8_t radius = 1; radius <= MAX_BLUR_RADIUS; radius++) {
+        static Grid actual, excess, expected;
+        randomGrid(actual, 900 + radius);
+        expected = actual;
+        for (uint16_t i = 0; i < NUM_LEDS; i++) {
+            const CRGB& color = actual.pixels[i];
+            excess.pixels[i] = CRGB(qsub8(color.r, threshold), qsub8(color.g, threshold), qsub8(color.b, threshold));
+        }
+        referenceBox(excess, radius);
+        referenceBox(excess, radius);
+        for (uint16_t i = 0; i < NUM_LEDS; i++) {
+            expected.pixels[i] += excess.pixels[i];
+        }
+        applyTo(fx, actual, {POSTFX_BLOOM, radius, threshold});
+        CHECK_EQ(countMismatches(actual, expected), 0);
+    }
+}
+
+// Una columna encendida se reparte a sus vecinas en la fila; en el anillo
+// la columna 0 es vecina de la última
+TEST(rowsWrapOnTheRing) {
+    static PostFx fx;
+    static Grid grid;
+    fill_solid(grid.pixels, NUM_LEDS, CRGB::Black);
+    for (uint8_t y = 0; y < Matrix::HEIGHT; y++) grid.at(0, y) = CRGB(255, 255, 255);
+    applyTo(fx, grid, {POSTFX_BOX, 1, 0});
+
+    const uint8_t third = (255 * 21846) >> 16;
+    const uint8_t twoThirds = (510 * 21846) >> 16;
+    for (uint8_t y = 0; y < Matrix::HEIGHT; y++) {
+        CHECK_EQ(grid.at(1, y).r, third);
+        CHECK_EQ(grid.at(2, y).r, 0);
+        if (Matrix::RING) {
+            CHECK_EQ(grid.at(0, y).r, third);
+            CHECK_EQ(grid.at(Matrix::WIDTH - 1, y).r, third);
+        } else {
+            CHECK_EQ(grid.at(0, y).r, twoThirds);
+            CHECK_EQ(grid.at(Matrix::WIDTH - 1, y).r, 0);
+        }
+    }
+}
+
+// Las columnas no dan la vuelta: la fila inferior repite su borde y la
+// superior no recibe nada de ella
+TEST(columnsClampAtTheEdges) {
+    static PostFx fx;
+    static Grid grid;
+    fill_solid(grid.pixels, NUM_LEDS, CRGB::Black);
+    for (uint8_t x = 0; x < Matrix::WIDTH; x++) grid.at(x, 0) = CRGB(0, 255, 0);
+    applyTo(fx, grid, {POSTFX_BOX, 1, 0});
+
+    const uint8_t third = (255 * 21846) >> 16;
+    const uint8_t twoThirds = (510 * 21846) >> 16;
+    for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+        CHECK_EQ(grid.at(x, 0).g, twoThirds);
+        CHECK_EQ(grid.at(x, 1).g, third);
+        CHECK_EQ(grid.at(x, 2).g, 0);
+        CHECK_EQ(grid.at(x, Matrix::HEIGHT - 1).g, 0);
+        CHECK_EQ(grid.at(x, 0).r, 0);
+    }
+}
+
+// Con el inverso redondeado hacia arriba, un frame uniforme no cambia: en
+// particular una ventana toda en 255 sigue dando 255
+TEST(uniformFrameKeepsItsLevel) {
+    static PostFx fx;
+    static CRGB leds[NUM_LEDS];
+    const uint8_t levels[] = {1, 2, 3, 64, 127, 128, 200, 254, 255};
+    for (uint8_t radius = 1; radius <= MAX_BLUR_RADIUS; radius++) {
+        for (uint8_t level : levels) {
+            for (PostFxMode mode : {POSTFX_BOX, POSTFX_GAUSSIAN}) {
+                fill_solid(leds, NUM_LEDS, CRGB(level, level, level));
+                fx.apply(leds, {mode, radius, 0});
+                uint32_t changed = 0;
+                for (uint16_t i = 0; i < NUM_LEDS; i++) {
+                    if (!(leds[i] == CRGB(level, level, level))) changed++;
+                }
+                CHECK_EQ(changed, 0);
+            }
+        }
+    }
+}
+
+TEST(namesRoundTrip) {
+    for (uint8_t i = 0; i < POSTFX_COUNT; i++) {
+        CHECK_EQ(PostFx::fromName(PostFx::name(static_cast<PostFxMode>(i))), i);
+    }
+    CHECK_EQ(PostFx::fromName("sharpen"), POSTFX_COUNT);
+    CHECK(strcmp(PostFx::name(POSTFX_COUNT), "none") == 0);
+}
+
+// Costo de apply() por radio; con la suma corrida no debería crecer con él
+TEST(applyBenchmark) {
+    static const uint32_t FRAMES = 2000;
+    static PostFx fx;
+    static CRGB leds[NUM_LEDS];
+    static Grid grid;
+    randomGrid(grid, 4242);
+    toLeds(grid, leds);
+
+    for (PostFxMode mode : {POSTFX_BOX, POSTFX_GAUSSIAN}) {
+        for (uint8_t radius = 1; radius <= MAX_BLUR_RADIUS; radius++) {
+            const auto start = std::chrono::steady_clock::now();
+            for (uint32_t frame = 0; frame < FRAMES; frame++) {
+                fx.apply(leds, {mode, radius, 0});
+            }
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            printf("     %s radio %u: %.2f us/frame\n", PostFx::name(mode), radius, seconds * 1e6 / FRAMES);
+        }
+    }
+}
+
+TEST_MAIN()
@@ -0,0 +1,200 @@
+#include "test_support.h"
+#include "power_limiter.h"
+#include "output_pipeline.h"
+#include <chrono>
+
+// Cálculo de referencia en punto flotante del modelo de consumo
+static double referenceFullScale(uint32_t red, uint32_t green, uint32_t blue) {
+    return (red * (double)LED_RED_MA + green * (double)LED_GREEN_MA + blue * (double)LED_BLUE_MA) / 255.0;
+}
+
+static const uint32_t IDLE = (uint32_t)NUM_LEDS * LED_IDLE_MA;
+
+// Frame pseudoaleatorio reproducible
+static void randomFrame(CRGB* leds, uint32_t seed) {
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        seed = seed * 1103515245 + 12345;
+        leds[i] = CRGB(seed >> 24, seed >> 16, seed >> 8);
+    }
+}
+
+static void referenceSums(const CRGB* leds, uint32_t& red, uint32_t& green, uint32_t& blue) {
+    red = green = blue = 0;
+    for (uint16_t i = 0; i < NUM_LEDS; i++) {
+        red += leds[i].r;
+        green += leds[i].g;
+        blue += leds[i].b;
+    }
+}
+
+TEST(fullScaleMatchesReference) {
+    const uint32_t cases[][3] = {
+        {0, 0, 0},
+        {255 * NUM_LEDS, 255 * NUM_LEDS, 255 * NUM_LEDS},
+        {255 * NUM_LEDS, 0, 0},
+        {12345, 67890, 4321},
+        {1, 1, 1},
+    };
+    for (const auto& sums : cases) {
+        const double expected = referenceFullScale(sums[0], sums[1], sums[2]);
+        CHECK_EQ(PowerLimiter::fullScaleCurrent(sums[0], sums[1], sums[2]), (uint32_t)expected);
+    }
+    // Blanco completo: la suma de corrientes de los tres canales por LED
+    CHECK_EQ(PowerLimiter::fullScaleCurrent(255 * NUM_LEDS, 255 * NUM_LEDS, 255 * NUM_LEDS),
+             (uint32_t)NUM_LEDS * (LED_RED_MA + LED_GREEN_MA + LED_BLUE_MA));
+}
+
+TEST(currentAtScalesWithBrightness) {
+    const uint32_t fullScale = 20000;
+    CHECK_EQ(PowerLimiter::currentAt(fullScale, 0), IDLE);
+    CHECK_EQ(PowerLimiter::currentAt(fullScale, 255), fullScale + IDLE);
+    CHECK_EQ(PowerLimiter::currentAt(fullScale, 128), (uint32_t)(fullScale * 128.0 / 255.0) + IDLE);
+}
+
+// El brillo máximo es el mayor que no pasa del presupuesto
+TEST(maxBrightnessIsLargestWithinBudget) {
+    CHECK_EQ(PowerLimiter::maxBrightness(0), 255);
+    for (uint32_t fullScale = 500; fullScale < 40000; fullScale += 731) {
+        const uint8_t cap = PowerLimiter::maxBrightness(fullScale);
+        const double reference = (POWER_BUDGET_MA - IDLE) * 255.0 / fullScale;
+        CHECK_EQ(cap, reference >= 255 ? 255 : (uint32_t)reference);
+        CHECK(PowerLimiter::currentAt(fullScale, cap) <= POWER_BUDGET_MA);
+        if (cap < 255) {
+            CHECK(fullScale * (cap + 1.0) / 255.0 + IDLE > POWER_BUDGET_MA);
+        }
+    }
+}
+
+// El límite usa las sumas del frame anterior; baja de golpe y sube de a
+// POWER_RELEASE_STEP por frame
+TEST(limitDropsAtOnceAndReleasesSlowly) {
+    PowerLimiter limiter;
+    const uint32_t white = 255 * NUM_LEDS;
+    const uint8_t whiteCap = PowerLimiter::maxBrightness(PowerLimiter::fullScaleCurrent(white, white, white));
+    CHECK(whiteCap < 255);
+
+    CHECK_EQ(limiter.limitFrame(255), 255);  // Sin frame anterior
+    limiter.setFrameSums(white, white, white);
+    CHECK_EQ(limiter.limitFrame(255), whiteCap);
+    CHECK_EQ(limiter.limitFrame(whiteCap / 2), whiteCap / 2);  // Lo pedido ya cabe
+
+    limiter.setFrameSums(0, 0, 0);
+    for (uint8_t frame = 1; frame <= 10; frame++) {
+        CHECK_EQ(limiter.limitFrame(255), min(255, whiteCap + frame * POWER_RELEASE_STEP));
+    }
+    CHECK_EQ(limiter.getStats().limitedFrames, 11);
+}
+
+TEST(energyIntegratesShownCurrent) {
+    PowerLimiter limiter;
+    const uint32_t red = 100 * NUM_LEDS;
+    limiter.setFrameSums(red, 0, 0);
+    const uint32_t milliamps = PowerLimiter::currentAt(PowerLimiter::fullScaleCurrent(red, 0, 0), 200);
+
+    // Una hora de frames; mA * V * us = nJ y 1 mWh = 3.6e9 nJ
+    const uint32_t frames = 3600000000ULL / FRAME_INTERVAL_US;
+    uint32_t now = 0;
+    for (uint32_t i = 0; i <= frames; i++, now += FRAME_INTERVAL_US) {
+        limiter.recordFrame(200, now);
+    }
+    const double expectedMwh = milliamps * (double)LED_VOLTAGE * frames * FRAME_INTERVAL_US / 3.6e9;
+    const double actualMwh = limiter.getStats().energyNanojoules / 3.6e9;
+    CHECK(fabs(actualMwh - expectedMwh) < 0.01);
+    CHECK_EQ(limiter.getStats().estimatedMilliamps, milliamps);
+
+    limiter.recordIdle(now);
+    CHECK_EQ(limiter.getStats().estimatedMilliamps, IDLE);
+    CHECK_EQ(limiter.getStats().peakMilliamps, milliamps);
+}
+
+// La conversión entrega las mismas sumas que una pasada aparte
+TEST(convertSumsMatchSeparatePass) {
+    static OutputPipeline pipeline;
+    static CRGB leds[NUM_LEDS];
+    pipeline.begin();
+    for (uint32_t seed = 1; seed <= 20; seed++) {
+        randomFrame(leds, seed);
+        pipeline.setEnabled(seed & 1);
+        pipeline.convert(leds, seed * 12);
+
+        uint32_t red, green, blue, expectedRed, expectedGreen, expectedBlue;
+        pipeline.getChannelSums(red, green, blue);
+        referenceSums(leds, expectedRed, expectedGreen, expectedBlue);
+        CHECK_EQ(red, expectedRed);
+        CHECK_EQ(green, expectedGreen);
+        CHECK_EQ(blue, expectedBlue);
+    }
+}
+
+// La salida con dithering es la de la conversión canal por canal: gamma
+// y brillo en 8.8 más el umbral de la fase del frame
+TEST(convertOutputMatchesReference) {
+    static OutputPipeline pipeline;
+    static CRGB leds[NUM_LEDS];
+    pipeline.begin();
+    pipeline.setEnabled(true);
+
+    for (uint8_t frame = 0; frame < 40; frame++) {
+        static const uint8_t SEQUENCE[16] = {8, 136, 72, 200, 40, 168, 104, 232, 24, 152, 88, 216, 56, 184, 120, 248};
+        const uint8_t brightness = 40 + frame * 5;
+        randomFrame(leds, 1000 + frame);
+        CHECK_EQ(pipeline.convert(leds, brightness), 255);
+
+        const uint8_t* in = reinterpret_cast<const uint8_t*>(leds);
+        const uint8_t* out = reinterpret_cast<const uint8_t*>(pipeline.buffer());
+        uint32_t mismatches = 0;
+        for (uint16_t i = 0; i < NUM_LEDS * 3; i++) {
+            const uint16_t gamma = (uint16_t)(powf(in[i] / 255.0f, OUTPUT_GAMMA) * 0xFF00 + 0.5f);
+            const uint16_t level = (uint32_t)gamma * brightness / 255;
+            const uint8_t expected = (level + SEQUENCE[(i + frame) & 15]) >> 8;
+            if (out[i] != expected) mismatches++;
+        }
+        CHECK_EQ(mismatches, 0);
+    }
+}
+
+// Costo de convert() con dithering (dos canales por palabra) contra la
+// misma conversión hecha canal por canal, como referencia
+TEST(convertBenchmark) {
+    static const uint8_t SEQUENCE[16] = {8, 136, 72, 200, 40, 168, 104, 232, 24, 152, 88, 216, 56, 184, 120, 248};
+    static const uint32_t FRAMES = 2000;
+    static const uint8_t BRIGHTNESS = 180;
+    static OutputPipeline pipeline;
+    static CRGB leds[NUM_LEDS];
+    static CRGB plain[NUM_LEDS];
+    pipeline.begin();
+    pipeline.setEnabled(true);
+    randomFrame(leds, 77);
+
+    uint16_t lut[256];
+    for (uint16_t i = 0; i < 256; i++) {
+        const uint16_t gamma = (uint16_t)(powf(i / 255.0f, OUTPUT_GAMMA) * 0xFF00 + 0.5f);
+        lut[i] = (uint32_t)gamma * BRIGHTNESS / 255;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < FRAMES; frame++) {
+        pipeline.convert(leds, BRIGHTNESS);
+    }
+    const double pairedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(leds);
+    uint8_t* out = reinterpret_cast<uint8_t*>(plain);
+    uint32_t red = 0, green = 0, blue = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < FRAMES; frame++) {
+        red = green = blue = 0;
+        for (uint16_t i = 0; i < NUM_LEDS * 3; i++) {
+            out[i] = (lut[in[i]] + SEQUENCE[(i + frame) & 15]) >> 8;
+        }
+        referenceSums(leds, red, green, blue);
+    }
+    const double plainSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Misma fase de dithering en ambos: el último frame tiene que coincidir
+    CHECK(memcmp(pipeline.buffer(), plain, sizeof(plain)) == 0);
+    printf("     convert: %.2f us/frame, canal por canal: %.2f us/frame (%.2fx)\n",
+           pairedSeconds * 1e6 / FRAMES, plainSeconds * 1e6 / FRAMES, plainSeconds / pairedSeconds);
+}
+
+TEST_MAIN()
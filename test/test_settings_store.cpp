@@ -0,0 +1,186 @@
+#include "test_support.h"
+#include "settings_store.h"
+
+// La NVS falsa vive en el directorio de trabajo (el de la compilación);
+// cada prueba empieza sin registros
+static void freshStorage() {
+    remove("ledfirepit.slotA");
+    remove("ledfirepit.slotB");
+    Preferences::restorePower();
+}
+
+static LedSettings makeSettings(uint8_t brightness) {
+    LedSettings settings;
+    memset(&settings, 0, sizeof(settings));
+    settings.effect = 3;
+    settings.brightness = brightness;
+    settings.hue = 40;
+    settings.saturation = 255;
+    settings.firePalette = 2;
+    settings.lifeSpeedQuarters = 4;
+    settings.isOn = true;
+    settings.autoRestart = true;
+    return settings;
+}
+
+static bool sameSettings(const LedSettings& a, const LedSettings& b) {
+    return memcmp(&a, &b, sizeof(LedSettings)) == 0;
+}
+
+TEST(emptyStorageRestoresNothing) {
+    freshStorage();
+    SettingsStore store;
+    LedSettings restored;
+    CHECK(!store.begin(restored));
+    CHECK_EQ(store.getSequence(), 0);
+}
+
+TEST(savedSettingsSurviveReboot) {
+    freshStorage();
+    {
+        SettingsStore store;
+        LedSettings ignored;
+        store.begin(ignored);
+        store.save(makeSettings(10));
+        store.save(makeSettings(20));
+        store.save(makeSettings(30));
+        CHECK_EQ(store.getFlashWrites(), 3);
+    }
+
+    SettingsStore rebooted;
+    LedSettings restored;
+    CHECK(rebooted.begin(restored));
+    CHECK(sameSettings(restored, makeSettings(30)));
+    CHECK_EQ(rebooted.getSequence(), 3);
+}
+
+TEST(unchangedSettingsAreNotWritten) {
+    freshStorage();
+    SettingsStore store;
+    LedSettings ignored;
+    store.begin(ignored);
+    store.save(makeSettings(10));
+    store.save(makeSettings(10));
+    CHECK_EQ(store.getFlashWrites(), 1);
+    CHECK_EQ(store.getSkippedWrites(), 1);
+}
+
+// Corte de energía en cada byte posible de la tercera escritura: al
+// reiniciar debe quedar la segunda, nunca un registro mezclado
+TEST(powerLossMidWriteKeepsPreviousRecord) {
+    LedSettings probe;
+    freshStorage();
+    {
+        SettingsStore store;
+        store.begin(probe);
+        store.save(makeSettings(1));
+    }
+    Preferences preferences;
+    preferences.begin("ledfirepit");
+    const long recordSize = preferences.getBytesLength("slotA");
+    CHECK(recordSize > 0);
+
+    for (long cut = 0; cut < recordSize; cut++) {
+        freshStorage();
+        {
+            SettingsStore store;
+            store.begin(probe);
+            store.save(makeSettings(10));
+            store.save(makeSettings(20));
+            Preferences::simulatePowerLoss(cut);
+            store.save(makeSettings(30));
+            CHECK_EQ(store.getFailedWrites(), 1);
+        }
+        Preferences::restorePower();
+
+        SettingsStore rebooted;
+        LedSettings restored;
+        CHECK(rebooted.begin(restored));
+        CHECK(sameSettings(restored, makeSettings(20)));
+        CHECK_EQ(rebooted.getSequence(), 2);
+
+        // La siguiente escritura reemplaza la ranura dañada
+        rebooted.save(makeSettings(40));
+        SettingsStore again;
+        CHECK(again.begin(restored));
+        CHECK(sameSettings(restored, makeSettings(40)));
+        CHECK_EQ(again.getSequence(), 3);
+        CHECK_EQ(again.getCorruptSlots(), 0);
+    }
+}
+
+TEST(writeBehindWaitsForChangesToSettle) {
+    WriteBehind writeBehind;
+    writeBehind.begin(0);
+
+    // Un slider arrastrado durante 3 s: un cambio cada 50 ms
+    uint32_t change = 0;
+    unsigned long now = 0;
+    uint32_t saves = 0;
+    for (; now < 3000; now += 50) {
+        change++;
+        if (writeBehind.due(change, now)) saves++;
+    }
+    CHECK_EQ(saves, 0);
+    CHECK(writeBehind.isDirty());
+
+    for (; now < 3000 + SETTINGS_SAVE_DELAY + 100; now += 50) {
+        if (writeBehind.due(change, now)) saves++;
+    }
+    CHECK_EQ(saves, 1);
+    CHECK(!writeBehind.isDirty());
+}
+
+// Sin pausas se guarda como máximo una vez por SETTINGS_MAX_DELAY
+TEST(writeBehindCapsTheDelayUnderConstantChanges) {
+    WriteBehind writeBehind;
+    writeBehind.begin(0);
+
+    uint32_t change = 0;
+    uint32_t saves = 0;
+    const unsigned long duration = SETTINGS_MAX_DELAY * 3 + 1000;
+    for (unsigned long now = 0; now < duration; now += 100) {
+        change++;
+        if (writeBehind.due(change, now)) saves++;
+    }
+    CHECK_EQ(saves, 3);
+}
+
+TEST(flushWritesOnlyWhenPending) {
+    WriteBehind writeBehind;
+    writeBehind.begin(7);
+    CHECK(!writeBehind.flushDue(7));
+    CHECK(writeBehind.flushDue(8));
+    CHECK(!writeBehind.flushDue(8));
+}
+
+// Un cambio justo antes de reiniciar (subida de firmware, OTA): flush()
+// lo guarda aunque el retraso de escritura no haya vencido
+TEST(flushBeforeRestartKeepsRecentChange) {
+    freshStorage();
+    {
+        SettingsStore store;
+        WriteBehind writeBehind;
+        LedSettings ignored;
+        store.begin(ignored);
+        writeBehind.begin(0);
+
+        store.save(makeSettings(10));
+        CHECK(!writeBehind.due(1, 0));
+        CHECK(!writeBehind.due(1, SETTINGS_SAVE_DELAY / 2));
+        CHECK(writeBehind.isDirty());
+
+        if (writeBehind.flushDue(1)) {
+            store.save(makeSettings(99));
+        }
+        CHECK(!writeBehind.isDirty());
+        CHECK_EQ(store.getFlashWrites(), 2);
+    }
+
+    SettingsStore rebooted;
+    LedSettings restored;
+    CHECK(rebooted.begin(restored));
+    CHECK(sameSettings(restored, makeSettings(99)));
+}
+
+TEST_MAIN()
@@ -0,0 +1,75 @@
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include <Arduino.h>
+#include <vector>
+
+// Marco mínimo para las pruebas en el host. TEST() registra una prueba;
+// CHECK() y CHECK_EQ() reportan el fallo y siguen, para ver todos los que
+// haya en una corrida. Cada archivo de prueba termina con TEST_MAIN().
+namespace HostTest {
+    struct Case {
+        const char* name;
+        void (*run)();
+    };
+
+    inline std::vector<Case>& cases() {
+        static std::vector<Case> registered;
+        return registered;
+    }
+
+    inline int failures = 0;
+
+    inline bool add(const char* name, void (*run)()) {
+        cases().push_back({name, run});
+        return true;
+    }
+
+    inline void fail(const char* file, int line, const char* what) {
+        fprintf(stderr, "%s:%d: falló %s\n", file, line, what);
+        failures++;
+    }
+
+    inline void failEqual(const char* file, int line, const char* what, long long actual, long long expected) {
+        fprintf(stderr, "%s:%d: falló %s (%lld != %lld)\n", file, line, what, actual, expected);
+        failures++;
+    }
+
+    inline int runAll() {
+        for (const Case& test : cases()) {
+            const int before = failures;
+            HostClock::set(0);
+            test.run();
+            printf("%s %s\n", failures == before ? "ok  " : "FAIL", test.name);
+        }
+        printf("%zu pruebas, %d fallos\n", cases().size(), failures);
+        return failures == 0 ? 0 : 1;
+    }
+}
+
+#define TEST(name)                                                   \
+    static void name();                                              \
+    static const bool name##Registered = HostTest::add(#name, name); \
+    static void name()
+
+#define CHECK(condition)                                          \
+    do {                                                          \
+        if (!(condition)) HostTest::fail(__FILE__, __LINE__, #condition); \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                  \
+    do {                                                                            \
+        const long long checkActual = (long long)(actual);                          \
+        const long long checkExpected = (long long)(expected);                      \
+        if (checkActual != checkExpected) {                                         \
+            HostTest::failEqual(__FILE__, __LINE__, #actual " == " #expected,       \
+                                checkActual, checkExpected);                        \
+        }                                                                           \
+    } while (0)
+
+#define TEST_MAIN() \
+    int main() {    \
+        return HostTest::runAll(); \
+    }
+
+#endif
@@ -0,0 +1,122 @@
+#include "test_support.h"
+#include "wifi_reconnect.h"
+
+// Driver WiFi simulado: el enlace existe fuera de la ventana de corte, y
+// begin() (como WiFi.begin()) regresa de inmediato; la conexión llega como
+// evento ASSOCIATION_MS después si hay enlace.
+struct FakeWifi {
+    static const unsigned long ASSOCIATION_MS = 50;
+
+    unsigned long outageStart;
+    unsigned long outageEnd;
+    bool connected = true;
+    bool pendingConnect = false;
+    unsigned long connectAt = 0;
+    uint32_t begins = 0;
+
+    FakeWifi(unsigned long start, unsigned long end) : outageStart(start), outageEnd(end) {}
+
+    bool linkUp(unsigned long now) const {
+        return now < outageStart || now >= outageEnd;
+    }
+
+    void begin(unsigned long now) {
+        begins++;
+        if (linkUp(now)) {
+            pendingConnect = true;
+            connectAt = now + ASSOCIATION_MS;
+        }
+    }
+
+    // Eventos del driver: true en lostEvent / gotIpEvent cuando ocurren
+    void poll(unsigned long now, bool& lostEvent, bool& gotIpEvent) {
+        lostEvent = gotIpEvent = false;
+        if (connected && !linkUp(now)) {
+            connected = false;
+            pendingConnect = false;
+            lostEvent = true;
+        }
+        if (pendingConnect && now >= connectAt) {
+            pendingConnect = false;
+            connected = true;
+            gotIpEvent = true;
+        }
+    }
+};
+
+// Un tick de 1 ms con la misma secuencia que OTAManager::handle(): eventos
+// del driver y, si toca, otro intento de conexión
+struct Simulation {
+    FakeWifi wifi;
+    WifiReconnect reconnect;
+
+    Simulation(unsigned long outageStart, unsigned long outageEnd) : wifi(outageStart, outageEnd) {
+        reconnect.onConnected(0);
+    }
+
+    void run(unsigned long untilMillis) {
+        while (millis() < untilMillis) {
+            const unsigned long now = millis();
+            bool lost, gotIp;
+            wifi.poll(now, lost, gotIp);
+            if (lost) reconnect.onDisconnected(now);
+            if (gotIp) reconnect.onConnected(now);
+            if (reconnect.retryDue(now)) {
+                wifi.begin(now);
+            }
+            HostClock::advanceMicros(1000);
+        }
+    }
+};
+
+// Corte de 10 s a 70 s: intentos a los 15, 25, 45 y 85 s (espera de 5 s
+// que se duplica); el enlace vuelve a los 70 s pero no se nota hasta el
+// intento de los 85 s
+TEST(retriesBackOffExponentially) {
+    Simulation simulation(10000, 70000);
+    simulation.run(120000);
+
+    CHECK(simulation.reconnect.isConnected());
+    CHECK_EQ(simulation.wifi.begins, 4);
+    CHECK_EQ(simulation.reconnect.getReconnectAttempts(), 4);
+    CHECK_EQ(simulation.reconnect.getReconnections(), 1);
+    CHECK_EQ(simulation.reconnect.getLastOutageDuration(), 85000 + FakeWifi::ASSOCIATION_MS - 10000);
+    CHECK_EQ(simulation.reconnect.getReconnectDelay(), WIFI_RETRY_DELAY);
+}
+
+TEST(retryDelayIsCapped) {
+    WifiReconnect reconnect;
+    reconnect.onDisconnected(1000);
+
+    unsigned long now = 1000;
+    uint32_t attempts = 0;
+    while (attempts < 10) {
+        now += 1000;
+        if (reconnect.retryDue(now)) attempts++;
+    }
+    CHECK_EQ(reconnect.getReconnectDelay(), WIFI_MAX_RETRY_DELAY);
+}
+
+TEST(outageStatisticsAccumulate) {
+    WifiReconnect reconnect;
+    CHECK(!reconnect.onConnected(100));
+
+    reconnect.onDisconnected(1000);
+    CHECK(reconnect.onConnected(4000));
+    reconnect.onDisconnected(10000);
+    CHECK(reconnect.onConnected(11000));
+
+    CHECK_EQ(reconnect.getReconnections(), 2);
+    CHECK_EQ(reconnect.getLastOutageDuration(), 1000);
+    CHECK_EQ(reconnect.getLongestOutageDuration(), 3000);
+    CHECK_EQ(reconnect.getTotalOutageDuration(), 4000);
+}
+
+TEST(noRetriesWhileConnected) {
+    WifiReconnect reconnect;
+    reconnect.onConnected(0);
+    CHECK(!reconnect.retryDue(WIFI_MAX_RETRY_DELAY * 10));
+    CHECK_EQ(reconnect.getReconnectAttempts(), 0);
+}
+
+TEST_MAIN()
@@ -0,0 +1,339 @@
+#ifndef TEXT_OVERLAY_H
+#define TEXT_OVERLAY_H
+
+#include <FastLED.h>
+#include <time.h>
+#include "config.h"
+#include "matrix_geometry.h"
+#include "fixed_string.h"
+#include "font.h"
+#include "text_scroller.h"
+#include "pixel_ops.h"
+
+// Texto que flota sobre cualquier efecto (la hora, el pasaje, un texto
+// libre o el versículo del día). El texto se rasteriza a una máscara por
+// pixel solo cuando cambia: un plano de cobertura del texto y otro de sombra
+// alrededor de las letras, para que se lea sobre el fuego. La máscara guarda
+// solo su caja (la fila de acentos, las de las letras y una de sombra
+// abajo), y cada frame se mezclan únicamente los pixels de esa caja. El
+// versículo no cabe: lo recorre un TextScroller, que cada frame copia su
+// ventana al plano del texto sobre una franja de sombra fija.
+//
+// Los textos y el color llegan desde async_tcp o la tarea del versículo:
+// se copian con el mutex tomado y el render los aplica solo si lo consigue
+// sin esperar; si no, lo intenta en el frame siguiente.
+enum OverlaySource : uint8_t {
+    OVERLAY_TEXT,     // Texto fijado por la API
+    OVERLAY_TIME,     // Hora local (SNTP)
+    OVERLAY_PASSAGE,  // libro:capítulo:versículo del día
+    OVERLAY_VERSE,    // Texto del versículo del día, desplazándose
+    OVERLAY_SOURCE_COUNT
+};
+
+class TextOverlay {
+public:
+    static constexpr const char* SOURCE_NAMES[OVERLAY_SOURCE_COUNT] = {"text", "time", "passage", "verse"};
+    static const uint8_t ROWS = Font::ROWS + 1;
+
+private:
+    // Máscara de la caja: fila 0 = arriba
+    uint8_t textAlpha[ROWS][Matrix::WIDTH];
+    uint8_t shadeAlpha[ROWS][Matrix::WIDTH];
+    uint8_t boxLeft;   // Columnas [boxLeft, boxRight) con algo que mezclar
+    uint8_t boxRight;
+    uint8_t boxBottom; // Fila de la matriz donde cae la última fila de la caja
+
+    FixedString<OVERLAY_TEXT_CAPACITY> shown;  // Texto de la máscara actual
+    FixedString<OVERLAY_TEXT_CAPACITY> customText;
+    time_t lastSecond;
+    uint32_t rebuilds;
+    bool scrolling;  // La máscara es la franja del versículo
+    TextScroller scroller;
+
+    // Configuración que escribe la API desde otra tarea. Los textos, el
+    // tono y la saturación se escriben y se aplican con el mutex tomado
+    SemaphoreHandle_t lock;
+    FixedString<OVERLAY_TEXT_CAPACITY> requestedText;
+    bool textPending;
+    uint8_t hue;
+    uint8_t saturation;
+    bool colorPending;
+    volatile bool enabled;
+    volatile OverlaySource source;
+    volatile uint8_t row;
+    volatile uint8_t opacity;
+    CRGB color;  // Solo lo toca el render
+
+    void rasterize(uint8_t bottom) {
+        memset(textAlpha, 0, sizeof(textAlpha));
+        memset(shadeAlpha, 0, sizeof(shadeAlpha));
+        boxBottom = bottom;
+        scrolling = false;
+        rebuilds++;
+
+        const uint16_t width = Font::measure(shown.c_str());
+        uint8_t x = width < Matrix::WIDTH ? (Matrix::WIDTH - width) / 2 : 0;
+
+        const char* p = shown.c_str();
+        Font::Glyph glyph;
+        while (x < Matrix::WIDTH && Font::next(p, glyph)) {
+            for (uint8_t gx = 0; gx < glyph.width && x < Matrix::WIDTH; gx++, x++) {
+                const uint8_t bits = Font::column(glyph, gx);
+                for (uint8_t gy = 0; gy < Font::ROWS; gy++) {
+                    if (bits & (1 << gy)) textAlpha[gy][x] = 255;
+                }
+            }
+            x += Font::SPACING;
+        }
+
+        // Sombra en los ocho vecinos de cada pixel del texto
+        boxLeft = Matrix::WIDTH;
+        boxRight = 0;
+        for (uint8_t y = 0; y < ROWS; y++) {
+            for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+                if (textAlpha[y][x] != 0) continue;
+                for (int8_t dy = -1; dy <= 1 && shadeAlpha[y][x] == 0; dy++) {
+                    for (int8_t dx = -1; dx <= 1; dx++) {
+                        const int8_t ny = y + dy;
+                        const int8_t nx = x + dx;
+                        if (ny >= 0 && ny < ROWS && nx >= 0 && nx < Matrix::WIDTH && textAlpha[ny][nx] != 0) {
+                            shadeAlpha[y][x] = OVERLAY_SHADOW_ALPHA;
+                            break;
+                        }
+                    }
+                }
+            }
+            for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+                if (textAlpha[y][x] != 0 || shadeAlpha[y][x] != 0) {
+                    boxLeft = min(boxLeft, x);
+                    boxRight = max(boxRight, (uint8_t)(x + 1));
+                }
+            }
+        }
+    }
+
+    // Franja fija de sombra a todo lo ancho; el texto lo copia el scroller
+    void beginScrolling(uint8_t bottom) {
+        memset(textAlpha, 0, sizeof(textAlpha));
+        memset(shadeAlpha, SCROLL_BAND_ALPHA, sizeof(shadeAlpha));
+        boxLeft = 0;
+        boxRight = Matrix::WIDTH;
+        boxBottom = bottom;
+        scrolling = true;
+        shown.clear();
+        rebuilds++;
+    }
+
+    // Texto que corresponde a este frame; false si no hay nada que mostrar
+    bool currentText(FixedString<OVERLAY_TEXT_CAPACITY>& text, uint8_t book, uint8_t chapter, uint8_t verse) {
+        switch (source) {
+            case OVERLAY_TIME: {
+                const time_t now = time(nullptr);
+                if (now < (time_t)MIN_VALID_EPOCH) return false;  // Aún sin SNTP
+                if (now == lastSecond) {
+                    text = shown;
+                    return true;
+                }
+                lastSecond = now;
+                struct tm local;
+                localtime_r(&now, &local);
+                const int hours = local.tm_hour % 12 == 0 ? 12 : local.tm_hour % 12;
+                text.appendf("%d:%02d", hours, local.tm_min);
+                return true;
+            }
+            case OVERLAY_PASSAGE:
+                if (book == 0) return false;
+                text.appendf("%u:%u:%u", book, chapter, verse);
+                return true;
+            default:
+                text = customText;
+                return !text.isEmpty();
+        }
+    }
+
+public:
+    TextOverlay()
+        : boxLeft(0),
+          boxRight(0),
+          boxBottom(0),
+          lastSecond(0),
+          rebuilds(0),
+          scrolling(false),
+          lock(nullptr),
+          textPending(false),
+          hue(0),
+          saturation(0),
+          colorPending(false),
+          enabled(false),
+          source(OVERLAY_TIME),
+          row(OVERLAY_ROW),
+          opacity(255),
+          color(CRGB::White) {
+        memset(textAlpha, 0, sizeof(textAlpha));
+        memset(shadeAlpha, 0, sizeof(shadeAlpha));
+    }
+
+    void begin() {
+        lock = xSemaphoreCreateMutex();
+    }
+
+    static const char* sourceName(OverlaySource value) {
+        return value < OVERLAY_SOURCE_COUNT ? SOURCE_NAMES[value] : SOURCE_NAMES[OVERLAY_TEXT];
+    }
+
+    // OVERLAY_SOURCE_COUNT si el nombre no existe
+    static OverlaySource sourceFromName(const char* value) {
+        for (uint8_t i = 0; i < OVERLAY_SOURCE_COUNT; i++) {
+            if (strcmp(value, SOURCE_NAMES[i]) == 0) return static_cast<OverlaySource>(i);
+        }
+        return OVERLAY_SOURCE_COUNT;
+    }
+
+    // Setters para la API: solo guardan valores, el render los aplica
+    void setEnabled(bool enable) {
+        enabled = enable;
+    }
+
+    void setSource(OverlaySource value) {
+        if (value < OVERLAY_SOURCE_COUNT) {
+            source = value;
+            lastSecond = 0;  // La hora se vuelve a formatear
+        }
+    }
+
+    void setText(const char* text) {
+        xSemaphoreTake(lock, portMAX_DELAY);
+        requestedText = text;
+        textPending = true;
+        xSemaphoreGive(lock);
+    }
+
+    void setRow(uint8_t value) {
+        row = min(value, (uint8_t)(Matrix::HEIGHT - ROWS));
+    }
+
+    void setOpacity(uint8_t value) {
+        opacity = value;
+    }
+
+    // Color del texto a brillo completo
+    void setColor(uint8_t newHue, uint8_t newSaturation) {
+        xSemaphoreTake(lock, portMAX_DELAY);
+        hue = newHue;
+        saturation = newSaturation;
+        colorPending = true;
+        xSemaphoreGive(lock);
+    }
+
+    // Texto del versículo; se rasteriza en el render al llegar
+    void setScrollText(const char* text) {
+        xSemaphoreTake(lock, portMAX_DELAY);
+        scroller.setText(text);
+        xSemaphoreGive(lock);
+    }
+
+    void setScrollSpeed(uint8_t columnsPerSecond) {
+        scroller.setSpeed(columnsPerSecond);
+    }
+
+    const TextScroller& getScroller() const {
+        return scroller;
+    }
+
+    bool isEnabled() const {
+        return enabled;
+    }
+
+    OverlaySource getSource() const {
+        return source;
+    }
+
+    uint8_t getRow() const {
+        return row;
+    }
+
+    uint8_t getOpacity() const {
+        return opacity;
+    }
+
+    uint8_t getHue() const {
+        return hue;
+    }
+
+    uint8_t getSaturation() const {
+        return saturation;
+    }
+
+    const char* getText() const {
+        return shown.c_str();
+    }
+
+    uint32_t getRebuilds() const {
+        return rebuilds;
+    }
+
+    // Se llama una vez por frame desde el render; reconstruye la máscara
+    // solo si el texto o la fila cambiaron
+    void update(uint8_t book, uint8_t chapter, uint8_t verse) {
+        if (xSemaphoreTake(lock, 0) == pdTRUE) {
+            if (textPending) {
+                textPending = false;
+                customText = requestedText;
+            }
+            if (colorPending) {
+                colorPending = false;
+                color = CHSV(hue, saturation, 255);
+            }
+            scroller.applyPending();
+            xSemaphoreGive(lock);
+        }
+        if (!enabled) return;
+
+        const uint8_t bottom = row;
+        if (source == OVERLAY_VERSE) {
+            if (!scrolling || bottom != boxBottom) {
+                beginScrolling(bottom);
+            }
+            scroller.advance();
+            scroller.blit(textAlpha);
+            return;
+        }
+
+        FixedString<OVERLAY_TEXT_CAPACITY> text;
+        if (!currentText(text, book, chapter, verse)) {
+            text.clear();
+        }
+        if (scrolling || text != shown.c_str() || bottom != boxBottom) {
+            shown = text;
+            rasterize(bottom);
+        }
+    }
+
+    // Mezclar sobre leds[] solo la caja del texto: primero se oscurece la
+    // sombra y luego se lleva el pixel hacia el color según su cobertura
+    void composite(CRGB* leds) const {
+        if (!enabled || boxLeft >= boxRight || opacity == 0) return;
+
+        const uint32_t packedColor = PixelOps::pack(color);
+        for (uint8_t y = 0; y < ROWS; y++) {
+            const uint8_t matrixY = boxBottom + ROWS - 1 - y;
+            for (uint8_t x = boxLeft; x < boxRight; x++) {
+                const uint8_t shade = shadeAlpha[y][x];
+                const uint8_t cover = textAlpha[y][x];
+                if ((shade | cover) == 0) continue;
+
+                CRGB& pixel = leds[Matrix::xy(x, matrixY)];
+                if (shade != 0) {
+                    pixel.nscale8(255 - scale8(shade, opacity));
+                }
+                if (cover != 0) {
+                    const uint8_t alpha = scale8(cover, opacity);
+                    pixel = PixelOps::unpack(PixelOps::lerp8x4(PixelOps::pack(pixel), packedColor,
+                                                               alpha + (alpha >> 7)));
+                }
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef TEXT_SCROLLER_H
+#define TEXT_SCROLLER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "matrix_geometry.h"
+#include "fixed_string.h"
+#include "font.h"
+
+// Texto largo que recorre la matriz de derecha a izquierda (el versículo del
+// día). Al recibir el texto se rasteriza una sola vez a una tira de columnas
+// de tamaño fijo: cada columna es un byte con los bits de sus filas (ver
+// Font::column). Cada frame solo se copia la ventana de Matrix::WIDTH
+// columnas; la posición lleva fracción (8.8) y cada pixel mezcla su columna
+// con la siguiente, así el desplazamiento es suave aunque avance menos de
+// una columna por frame. El texto pedido no tiene protección propia: quien
+// llama a setText() y applyPending() desde tareas distintas las serializa
+// (ver TextOverlay).
+class TextScroller {
+private:
+    uint8_t strip[SCROLL_STRIP_COLUMNS];
+    uint16_t length;       // Columnas usadas de strip
+    bool truncated;        // El texto no cupo completo
+    uint32_t position;     // Columna virtual del borde izquierdo (8.8)
+    uint32_t rasterizations;
+
+    // Pedidos desde otra tarea; se aplican en el render
+    FixedString<VERSE_TEXT_CAPACITY> requestedText;
+    bool pending;
+    volatile uint8_t speed;          // Columnas por segundo
+    volatile uint16_t stepPerFrame;  // Columnas por frame (8.8)
+
+    void rasterize(const char* text) {
+        length = 0;
+        truncated = false;
+        position = 0;
+        rasterizations++;
+
+        Font::Glyph glyph;
+        while (Font::next(text, glyph)) {
+            if (length + glyph.width > SCROLL_STRIP_COLUMNS) {
+                truncated = true;
+                break;
+            }
+            for (uint8_t x = 0; x < glyph.width; x++) {
+                strip[length++] = Font::column(glyph, x);
+            }
+            for (uint8_t x = 0; x < Font::SPACING && length < SCROLL_STRIP_COLUMNS; x++) {
+                strip[length++] = 0;
+            }
+        }
+    }
+
+    // Antes del texto hay Matrix::WIDTH columnas vacías, así que entra por
+    // la derecha y sale completo por la izquierda antes de repetirse
+    uint8_t columnAt(uint32_t virtualColumn) const {
+        if (virtualColumn < Matrix::WIDTH) return 0;
+        const uint32_t index = virtualColumn - Matrix::WIDTH;
+        return index < length ? strip[index] : 0;
+    }
+
+public:
+    TextScroller()
+        : length(0),
+          truncated(false),
+          position(0),
+          rasterizations(0),
+          pending(false),
+          speed(0),
+          stepPerFrame(0) {
+        setSpeed(SCROLL_SPEED);
+    }
+
+    void setText(const char* text) {
+        requestedText = text;
+        pending = true;
+    }
+
+    // Columnas por segundo
+    void setSpeed(uint8_t columnsPerSecond) {
+        speed = columnsPerSecond;
+        stepPerFrame = (uint32_t)columnsPerSecond * 256 * FRAME_INTERVAL_US / 1000000;
+    }
+
+    uint8_t getSpeed() const {
+        return speed;
+    }
+
+    uint16_t getLength() const {
+        return length;
+    }
+
+    bool isTruncated() const {
+        return truncated;
+    }
+
+    uint32_t getRasterizations() const {
+        return rasterizations;
+    }
+
+    // Rasterizar el texto pedido, si llegó uno (desde el render)
+    void applyPending() {
+        if (!pending) return;
+        pending = false;
+        rasterize(requestedText.c_str());
+    }
+
+    // Avanzar un frame
+    void advance() {
+        if (length == 0) return;
+        const uint32_t total = (uint32_t)(length + Matrix::WIDTH) << 8;
+        position += stepPerFrame;
+        if (position >= total) position -= total;
+    }
+
+    // Copiar la ventana visible como cobertura por pixel (0-255) en las
+    // Font::ROWS primeras filas de alpha
+    void blit(uint8_t (*alpha)[Matrix::WIDTH]) const {
+        const uint32_t base = position >> 8;
+        const uint16_t fraction = position & 0xFF;
+
+        uint8_t left = columnAt(base);
+        for (uint8_t x = 0; x < Matrix::WIDTH; x++) {
+            const uint8_t right = columnAt(base + x + 1);
+            for (uint8_t row = 0; row < Font::ROWS; row++) {
+                const uint16_t cover = ((left >> row) & 1 ? 256 - fraction : 0) + ((right >> row) & 1 ? fraction : 0);
+                alpha[row][x] = cover > 255 ? 255 : cover;
+            }
+            left = right;
+        }
+    }
+};
+
+#endif
@@ -3,174 +3,36 @@
 
 #include <ESPAsyncWebServer.h>
 #include <AsyncTCP.h>
-#include <WiFiClientSecure.h>
 #include <ArduinoJson.h>
 #include "led_manager.h"
+#include "preview_stream.h"
+#include "firmware_updater.h"
+#include "settings_manager.h"
+#include "network_task.h"
+#include "boot_timeline.h"
+#include "fixed_string.h"
+#include "daily_verse.h"
 
 class WebManager {
 private:
     AsyncWebServer server;
     LedManager* ledManager;
-    String cachedVerse;
-    String cachedReference;
-    unsigned long lastVerseUpdate = 0;
-    const unsigned long VERSE_UPDATE_INTERVAL = 3600000; // 1 hora en milisegundos
+    PreviewStream previewStream;
+    FirmwareUpdater firmwareUpdater;
+    SettingsManager* settingsManager = nullptr;
+    NetworkTask* networkTask = nullptr;
+    std::function<bool(AsyncWebServerRequest*)> apiFallback;
+    DailyVerse dailyVerse;
     uint32_t stateVersion = 0;  // Contador de cambios de estado
 
     void incrementStateVersion() {
         stateVersion++;
     }
 
-    uint8_t getBookNumber(String bookName) {
-        const char* bookNames[] = {
-            "Genesis", "Exodus", "Leviticus", "Numbers", "Deuteronomy",
-            "Joshua", "Judges", "Ruth", "1 Samuel", "2 Samuel",
-            "1 Kings", "2 Kings", "1 Chronicles", "2 Chronicles",
-            "Ezra", "Nehemiah", "Esther", "Job", "Psalms", "Proverbs",
-            "Ecclesiastes", "Song of Solomon", "Isaiah", "Jeremiah",
-            "Lamentations", "Ezekiel", "Daniel", "Hosea", "Joel", "Amos",
-            "Obadiah", "Jonah", "Micah", "Nahum", "Habakkuk", "Zephaniah",
-            "Haggai", "Zechariah", "Malachi",
-            "Matthew", "Mark", "Luke", "John", "Acts", "Romans",
-            "1 Corinthians", "2 Corinthians", "Galatians", "Ephesians",
-            "Philippians", "Colossians", "1 Thessalonians", "2 Thessalonians",
-            "1 Timothy", "2 Timothy", "Titus", "Philemon", "Hebrews",
-            "James", "1 Peter", "2 Peter", "1 John", "2 John", "3 John",
-            "Jude", "Revelation"
-        };
-
-        for (uint8_t i = 0; i < 66; i++) {
-            if (bookName.equals(bookNames[i])) {
-                return i + 1;  // Los números de libro empiezan en 1
-            }
-        }
-        return 1;  // Por defecto, retorna 1 (Genesis)
-    }
-
-    String getVerse(String& reference) {
-        unsigned long currentMillis = millis();
-        
-        // Si tenemos un versículo cacheado y no ha pasado el intervalo, lo usamos
-        if (!cachedVerse.isEmpty() && (currentMillis - lastVerseUpdate < VERSE_UPDATE_INTERVAL)) {
-            reference = cachedReference;
-            return cachedVerse;
-        }
-
-        // Si necesitamos actualizar, hacemos la petición
-        String newVerse = fetchDailyVerse(reference);
-        if (newVerse != "No data") {
-            cachedVerse = newVerse;
-            cachedReference = reference;
-            lastVerseUpdate = currentMillis;
-        } else if (!cachedVerse.isEmpty()) {
-            // Si la petición falló pero tenemos datos cacheados, los usamos
-            reference = cachedReference;
-            return cachedVerse;
-        }
-        
-        return newVerse;
-    }
-
-    String fetchDailyVerse(String& reference) {  // Añadimos un parámetro por referencia
-        WiFiClientSecure client;
-        String result = "No data";
-        reference = "Información del Reloj";  // Valor por defecto
-        
-        client.setInsecure();
-        
-        if (client.connect("labs.bible.org", 443)) {
-            client.println("GET /api/?passage=votd&type=json HTTP/1.1");
-            client.println("Host: labs.bible.org");
-            client.println("User-Agent: Mozilla/5.0");
-            client.println("Accept: application/json");
-            client.println("Connection: close");
-            client.println();
-
-            while (client.connected()) {
-                String line = client.readStringUntil('\n');
-                if (line == "\r") {
-                    break;
-                }
-            }
-
-            String response = client.readString();
-            int jsonStart = response.indexOf('[');
-            if (jsonStart != -1) {
-                response = response.substring(jsonStart);
-                
-                StaticJsonDocument<1024> doc;
-                DeserializationError error = deserializeJson(doc, response);
-                
-                if (!error) {
-                    String bookName = doc[0]["bookname"].as<String>();
-                    int chapter = doc[0]["chapter"].as<unsigned int>();
-                    int verse = doc[0]["verse"].as<unsigned int>();
-                    String text = doc[0]["text"].as<String>();
-
-                    ledManager->setBook(getBookNumber(bookName));
-                    ledManager->setChapter(chapter);
-                    ledManager->setVerse(verse);
-
-                    bookName = translateText(bookName);
-                    text = translateText(text);
-                    
-                    // Guardar la referencia separada
-                    reference = bookName + " " + chapter + ":" + verse;
-                    // Solo el texto para el contenido
-                    result = text;
-                }
-            }
-        }
-        
-        client.stop();
-        return result;
-    }
-
-    String translateText(String text) {
-        WiFiClient client;
-        String translated = text;  // Por defecto retornamos el texto original
-
-        if (client.connect("clients5.google.com", 80)) {
-            // Codificar el texto para URL
-            text.replace(" ", "%20");
-            
-            String url = "/translate_a/t?client=dict-chrome-ex&sl=en&tl=es&q=" + text;
-            
-            client.println("GET " + url + " HTTP/1.1");
-            client.println("Host: clients5.google.com");
-            client.println("User-Agent: Mozilla/5.0");
-            client.println("Connection: close");
-            client.println();
-
-            // Esperar la respuesta
-            while (client.connected()) {
-                String line = client.readStringUntil('\n');
-                if (line == "\r") {
-                    break;
-                }
-            }
-
-            String response = client.readString();
-            int jsonStart = response.indexOf('[');
-            if (jsonStart != -1) {
-                response = response.substring(jsonStart);
-                
-                StaticJsonDocument<1024> doc;
-                DeserializationError error = deserializeJson(doc, response);
-                
-                if (!error) {
-                    translated = doc[0].as<String>();
-                }
-            }
-        }
-        
-        client.stop();
-        return translated;
-    }
-    
     void setupRoutes() {
         server.on("/", HTTP_GET, [](AsyncWebServerRequest *request){
-            request->send(200, "text/html", getIndexHTML());
+            request->send_P(200, "text/html", getIndexHTML());
+            BootTimeline::instance().mark(BOOT_FIRST_HTTP_RESPONSE);
         });
 
         server.on("/api/status", HTTP_GET, [this](AsyncWebServerRequest *request){
@@ -181,9 +43,16 @@ private:
             doc["effect"] = static_cast<int>(ledManager->getCurrentEffect());  // Añadir cast explícito
             doc["state"] = ledManager->getState();
             doc["brightness"] = ledManager->getBrightness();
+            doc["transition"] = ledManager->getTransitionDuration();
+            doc["quality"] = FrameScheduler::qualityName(ledManager->getQuality());
+            doc["dither"] = ledManager->isHighDepthOutput();
+            doc["symmetry"] = Symmetry::name(ledManager->getSymmetry(ledManager->getCurrentEffect()));
+            doc["postFx"] = PostFx::name(ledManager->getPostFxSettings(ledManager->getCurrentEffect()).mode);
             
             // Añadir el resto de la información según el efecto actual
             LedEffect currentEffect = ledManager->getCurrentEffect();
+            FixedString<VERSE_TEXT_CAPACITY> verseText;  // El documento guarda punteros
+            FixedString<VERSE_REFERENCE_CAPACITY> verseReference;
             
             switch(currentEffect) {
                 case SOLID:
@@ -208,30 +77,137 @@ private:
                     break;
                     
                 case CLOCK:
-                    String reference;
-                    doc["clockText"] = getVerse(reference);
-                    doc["passageReference"] = reference;
+                    // Solo se lee la copia publicada; la descarga es de DailyVerse
+                    dailyVerse.request();
+                    if (dailyVerse.read(verseText, verseReference)) {
+                        doc["clockText"] = verseText.c_str();
+                        doc["passageReference"] = verseReference.c_str();
+                    } else {
+                        doc["clockText"] = "No data";
+                        doc["passageReference"] = "Información del Reloj";
+                    }
                     break;
             }
             
+            TextOverlay& textOverlay = ledManager->getOverlay();
+            JsonObject overlay = doc.createNestedObject("overlay");
+            overlay["enabled"] = textOverlay.isEnabled();
+            overlay["source"] = TextOverlay::sourceName(textOverlay.getSource());
+            overlay["text"] = textOverlay.getText();
+            overlay["row"] = textOverlay.getRow();
+            overlay["opacity"] = textOverlay.getOpacity();
+            overlay["hue"] = textOverlay.getHue();
+            overlay["saturation"] = textOverlay.getSaturation();
+            overlay["rebuilds"] = textOverlay.getRebuilds();
+            const TextScroller& scroller = textOverlay.getScroller();
+            overlay["speed"] = scroller.getSpeed();
+            overlay["scrollColumns"] = scroller.getLength();
+            overlay["scrollTruncated"] = scroller.isTruncated();
+
+            JsonArray layers = doc.createNestedArray("layers");
+            for (uint8_t i = 0; i < OVERLAY_LAYERS; i++) {
+                const LayerConfig layer = ledManager->getLayer(i);
+                JsonObject entry = layers.createNestedObject();
+                entry["effect"] = static_cast<int>(layer.effect);
+                entry["blend"] = LayerCompositor::blendName(layer.blend);
+                entry["opacity"] = layer.opacity;
+                entry["hueShift"] = layer.hueShift;
+                entry["mask"] = LayerCompositor::maskName(layer.mask);
+                entry["symmetry"] = Symmetry::name(layer.symmetry);
+                entry["postFx"] = PostFx::name(layer.postFx.mode);
+            }
+
+            JsonObject preview = doc.createNestedObject("preview");
+            preview["clients"] = previewStream.getClientCount();
+            preview["sent"] = previewStream.getFramesSent();
+            preview["dropped"] = previewStream.getFramesDropped();
+            preview["bytes"] = previewStream.getBytesSent();
+            preview["encodeMicros"] = previewStream.getLastEncodeMicros();
+            preview["interval"] = previewStream.getInterval();
+
+            if (settingsManager != nullptr) {
+                JsonObject settings = doc.createNestedObject("settings");
+                settings["sequence"] = settingsManager->getSequence();
+                settings["flashWrites"] = settingsManager->getFlashWrites();
+                settings["skippedWrites"] = settingsManager->getSkippedWrites();
+                settings["failedWrites"] = settingsManager->getFailedWrites();
+                settings["pending"] = settingsManager->isDirty();
+            }
+
+            if (networkTask != nullptr) {
+                JsonObject network = doc.createNestedObject("network");
+                network["wakeupsPerSecond"] = networkTask->getWakeupsPerSecond();
+                network["loadPermille"] = networkTask->getBusyPermille();
+                JsonObject services = network.createNestedObject("services");
+                for (uint8_t i = 0; i < networkTask->getServiceCount(); i++) {
+                    const NetworkTask::ServiceStats& stats = networkTask->getServiceStats(i);
+                    JsonObject service = services.createNestedObject(stats.name);
+                    service["loadPermille"] = stats.loadPermille;
+                    service["maxMicros"] = stats.maxMicros;
+                }
+            }
+
+            JsonObject memory = doc.createNestedObject("memory");
+            memory["freeHeap"] = ESP.getFreeHeap();
+            memory["render"] = sizeof(LedManager);
+            memory["renderBudget"] = RENDER_MEMORY_BUDGET;
+            memory["preview"] = sizeof(PreviewStream);
+            memory["previewBudget"] = PREVIEW_MEMORY_BUDGET;
+            memory["effectArena"] = EFFECT_ARENA_SIZE;
+            memory["effectActive"] = ledManager->getEffectMemory();
+            JsonObject footprints = memory.createNestedObject("effects");
+            for (uint8_t i = 0; i < EFFECT_FOOTPRINT_COUNT; i++) {
+                footprints[EFFECT_FOOTPRINTS[i].name] = EFFECT_FOOTPRINTS[i].bytes;
+            }
+
+            JsonObject boot = doc.createNestedObject("boot");
+            for (uint8_t i = 0; i < BOOT_EVENT_COUNT; i++) {
+                BootEvent event = static_cast<BootEvent>(i);
+                if (BootTimeline::instance().has(event)) {
+                    boot[BootTimeline::eventName(event)] = BootTimeline::instance().get(event);
+                }
+            }
+
+            response.reserve(measureJson(doc));
             serializeJson(doc, response);
-            Serial.println("Sending status: " + response);  // Debug
             request->send(200, "application/json", response);
+            BootTimeline::instance().mark(BOOT_FIRST_HTTP_RESPONSE);
+        });
+
+        // Ritmo de frames, consumo estimado e histogramas por etapa
+        server.on("/api/metrics", HTTP_GET, [this](AsyncWebServerRequest *request){
+            AsyncResponseStream* response = request->beginResponseStream("application/json");
+            response->print("{\"scheduler\":");
+            ledManager->getScheduler().printJson(*response);
+            response->print(",\"power\":");
+            ledManager->getPower().printJson(*response);
+            response->print(",\"postFx\":");
+            ledManager->getPostFx().printJson(*response);
+            response->print(",");
+            ledManager->getMetrics().printFields(*response);
+            response->print("}");
+            request->send(response);
+        });
+
+        server.on("/api/metrics/reset", HTTP_POST, [this](AsyncWebServerRequest *request){
+            ledManager->resetMetrics();
+            request->send(200);
         });
 
         // Endpoint de color para manejar tanto hue como saturación
                 server.on("/api/color", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
             [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
-                String json = String((char*)data);
                 StaticJsonDocument<200> doc;
-                DeserializationError error = deserializeJson(doc, json);
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
                 
                 if (!error) {
+                    // "transition" opcional: duración de la rampa en ms
+                    const uint16_t rampMs = doc["transition"] | PARAM_RAMP_MS;
                     if (doc.containsKey("hue")) {
-                        ledManager->setHue(doc["hue"].as<uint8_t>());
+                        ledManager->setHue(doc["hue"].as<uint8_t>(), rampMs);
                     }
                     if (doc.containsKey("saturation")) {
-                        ledManager->setSaturation(doc["saturation"].as<uint8_t>());
+                        ledManager->setSaturation(doc["saturation"].as<uint8_t>(), rampMs);
                     }
                 }
                 request->send(200);
@@ -239,9 +215,8 @@ private:
 
         server.on("/api/state", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
             [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
-                String json = String((char*)data);
                 StaticJsonDocument<200> doc;
-                DeserializationError error = deserializeJson(doc, json);
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
                 
                 if (!error && doc.containsKey("state")) {
                     ledManager->setState(doc["state"].as<bool>());
@@ -251,21 +226,167 @@ private:
 
         server.on("/api/brightness", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
             [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
-                String json = String((char*)data);
                 StaticJsonDocument<200> doc;
-                DeserializationError error = deserializeJson(doc, json);
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
                 
                 if (!error && doc.containsKey("brightness")) {
-                    ledManager->setBrightness(doc["brightness"].as<uint8_t>());
+                    ledManager->setBrightness(doc["brightness"].as<uint8_t>(),
+                                              doc["transition"] | PARAM_RAMP_MS);
+                }
+                request->send(200);
+            });
+
+        server.on("/api/transition", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
+            [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+                StaticJsonDocument<200> doc;
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
+
+                if (!error && doc.containsKey("duration")) {
+                    ledManager->setTransitionDuration(doc["duration"].as<uint16_t>());
+                }
+                request->send(200);
+            });
+
+        server.on("/api/dither", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
+            [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+                StaticJsonDocument<200> doc;
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
+
+                if (!error && doc.containsKey("enabled")) {
+                    ledManager->setHighDepthOutput(doc["enabled"].as<bool>());
+                }
+                request->send(200);
+            });
+
+        // Sin "effect" se aplica al efecto actual
+        server.on("/api/symmetry", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
+            [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+                StaticJsonDocument<200> doc;
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
+
+                const SymmetryMode mode = !error && doc["mode"].is<const char*>()
+                    ? Symmetry::fromName(doc["mode"].as<const char*>()) : SYMMETRY_COUNT;
+                const int target = doc["effect"] | static_cast<int>(ledManager->getCurrentEffect());
+                if (mode == SYMMETRY_COUNT || target < 0 || target >= OFF) {
+                    request->send(400);
+                    return;
+                }
+                ledManager->setSymmetry(static_cast<LedEffect>(target), mode);
+                request->send(200);
+            });
+
+        // Sin "effect" se aplica al efecto actual; radio y umbral conservan
+        // su valor si se omiten
+        server.on("/api/postfx", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
+            [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+                StaticJsonDocument<200> doc;
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
+
+                const PostFxMode mode = !error && doc["mode"].is<const char*>()
+                    ? PostFx::fromName(doc["mode"].as<const char*>()) : POSTFX_COUNT;
+                const int target = doc["effect"] | static_cast<int>(ledManager->getCurrentEffect());
+                if (mode == POSTFX_COUNT || target < 0 || target >= OFF) {
+                    request->send(400);
+                    return;
+                }
+                const PostFxSettings current = ledManager->getPostFxSettings(static_cast<LedEffect>(target));
+                ledManager->setPostFx(static_cast<LedEffect>(target), mode,
+                                      doc["radius"] | current.radius,
+                                      doc["threshold"] | current.threshold);
+                request->send(200);
+            });
+
+        // Los campos omitidos conservan su valor; "effect" con el valor de OFF apaga la capa
+        server.on("/api/layer", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
+            [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+                StaticJsonDocument<256> doc;
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
+
+                const int layer = doc["layer"] | -1;
+                if (error || layer < 0 || layer >= OVERLAY_LAYERS) {
+                    request->send(400);
+                    return;
+                }
+
+                LayerConfig config = ledManager->getLayer(layer);
+                const int effect = doc["effect"] | static_cast<int>(config.effect);
+                if (effect < 0 || effect > OFF) {
+                    request->send(400);
+                    return;
+                }
+                config.effect = static_cast<LedEffect>(effect);
+                if (doc["blend"].is<const char*>()) {
+                    config.blend = LayerCompositor::blendFromName(doc["blend"].as<const char*>());
+                }
+                if (doc["mask"].is<const char*>()) {
+                    config.mask = LayerCompositor::maskFromName(doc["mask"].as<const char*>());
+                }
+                if (doc["symmetry"].is<const char*>()) {
+                    config.symmetry = Symmetry::fromName(doc["symmetry"].as<const char*>());
+                }
+                if (doc["postFx"].is<const char*>()) {
+                    config.postFx.mode = PostFx::fromName(doc["postFx"].as<const char*>());
+                }
+                config.opacity = doc["opacity"] | config.opacity;
+                config.hueShift = doc["hueShift"] | config.hueShift;
+                config.postFx.radius = doc["radius"] | config.postFx.radius;
+                config.postFx.threshold = doc["threshold"] | config.postFx.threshold;
+                if (config.blend == BLEND_MODE_COUNT || config.mask == LAYER_MASK_COUNT ||
+                    config.symmetry == SYMMETRY_COUNT || config.postFx.mode == POSTFX_COUNT) {
+                    request->send(400);
+                    return;
+                }
+
+                ledManager->setLayer(layer, config);
+                request->send(200);
+            });
+
+        // Todos los campos son opcionales
+        server.on("/api/overlay", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
+            [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+                StaticJsonDocument<256> doc;
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
+                if (error) {
+                    request->send(400);
+                    return;
+                }
+
+                TextOverlay& overlay = ledManager->getOverlay();
+                if (doc["source"].is<const char*>()) {
+                    const OverlaySource source = TextOverlay::sourceFromName(doc["source"].as<const char*>());
+                    if (source == OVERLAY_SOURCE_COUNT) {
+                        request->send(400);
+                        return;
+                    }
+                    overlay.setSource(source);
+                }
+                if (doc["text"].is<const char*>()) {
+                    overlay.setText(doc["text"].as<const char*>());
+                }
+                if (doc.containsKey("row")) {
+                    overlay.setRow(doc["row"].as<uint8_t>());
+                }
+                if (doc.containsKey("opacity")) {
+                    overlay.setOpacity(doc["opacity"].as<uint8_t>());
+                }
+                if (doc.containsKey("speed")) {
+                    overlay.setScrollSpeed(doc["speed"].as<uint8_t>());
+                }
+                // El campo que no venga conserva su valor actual
+                if (doc.containsKey("hue") || doc.containsKey("saturation")) {
+                    overlay.setColor(doc["hue"] | overlay.getHue(),
+                                     doc["saturation"] | overlay.getSaturation());
+                }
+                if (doc.containsKey("enabled")) {
+                    overlay.setEnabled(doc["enabled"].as<bool>());
                 }
                 request->send(200);
             });
 
         server.on("/api/effect", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
             [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
-                String json = String((char*)data);
                 StaticJsonDocument<200> doc;
-                DeserializationError error = deserializeJson(doc, json);
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
                 
                 if (!error && doc.containsKey("effect")) {
                     ledManager->setEffect(static_cast<LedEffect>(doc["effect"].as<int>()));
@@ -275,20 +396,18 @@ private:
         
                 server.on("/api/rainbow-type", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
             [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
-                String json = String((char*)data);
                 StaticJsonDocument<200> doc;
-                DeserializationError error = deserializeJson(doc, json);
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
                 
                 if (!error && doc.containsKey("type")) {
-                    String type = doc["type"].as<String>();
-                    ledManager->setRainbowType(type);
-                    
-                    String response;
+                    ledManager->setRainbowType(doc["type"].as<const char*>());
+
+                    char response[64];
                     StaticJsonDocument<200> responseDoc;
                     responseDoc["success"] = true;
-                    responseDoc["type"] = type;
-                    serializeJson(responseDoc, response);
-                    
+                    responseDoc["type"] = ledManager->getRainbowType();
+                    serializeJson(responseDoc, response, sizeof(response));
+
                     request->send(200, "application/json", response);
                 } else {
                     request->send(400);
@@ -297,9 +416,8 @@ private:
         
         server.on("/api/fire-palette", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
             [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
-                String json = String((char*)data);
                 StaticJsonDocument<200> doc;
-                DeserializationError error = deserializeJson(doc, json);
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
                 
                 if (!error && doc.containsKey("palette")) {
                     uint8_t palette = doc["palette"].as<uint8_t>();
@@ -312,9 +430,8 @@ private:
 
         server.on("/api/life-pattern", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
             [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
-                String json = String((char*)data);
                 StaticJsonDocument<200> doc;
-                DeserializationError error = deserializeJson(doc, json);
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
                 
                 if (!error && doc.containsKey("pattern")) {
                     uint8_t pattern = doc["pattern"].as<uint8_t>();
@@ -327,9 +444,8 @@ private:
 
         server.on("/api/life-auto-restart", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
             [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
-                String json = String((char*)data);
                 StaticJsonDocument<200> doc;
-                DeserializationError error = deserializeJson(doc, json);
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
                 
                 if (!error && doc.containsKey("enabled")) {
                     bool enabled = doc["enabled"].as<bool>();
@@ -342,9 +458,8 @@ private:
 
         server.on("/api/life-speed", HTTP_POST, [](AsyncWebServerRequest *request){}, NULL,
             [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
-                String json = String((char*)data);
                 StaticJsonDocument<200> doc;
-                DeserializationError error = deserializeJson(doc, json);
+                DeserializationError error = deserializeJson(doc, (const char*)data, len);
                 
                 if (!error && doc.containsKey("speed")) {
                     float speed = doc["speed"].as<float>();
@@ -355,12 +470,14 @@ private:
                 }
             });
 
-        server.onNotFound([](AsyncWebServerRequest *request){
+        // Las rutas desconocidas pueden ser llamadas de Alexa (/api/<usuario>/lights/...)
+        server.onNotFound([this](AsyncWebServerRequest *request){
+            if (apiFallback && apiFallback(request)) return;
             request->send(404, "text/plain", "Not found");
         });
     }
 
-        static String getIndexHTML() {
+        static const char* getIndexHTML() {
         return R"HTMLCONTENT(
 <!DOCTYPE html>
 <html lang="es">
@@ -920,6 +1037,14 @@ private:
             line-height: 1.5;
         }
 
+        .preview-canvas {
+            width: 100%;
+            aspect-ratio: 27 / 26;
+            image-rendering: pixelated;
+            background-color: #000;
+            border-radius: 8px;
+        }
+
         @media (max-width: 480px) {
             .color-sliders {
                 grid-template-columns: 1fr;
@@ -1105,6 +1230,11 @@ private:
         </div>
         <div class="status" id="status"></div>
     </div>
+
+    <div class="card">
+        <label>Vista previa</label>
+        <canvas id="previewCanvas" class="preview-canvas" width="27" height="26"></canvas>
+    </div>
         <script>
 
         let currentRainbowType = 'diagonal';
@@ -1181,7 +1311,7 @@ private:
 
         // Crear versiones debounced de las funciones de actualización
         const debouncedUpdateBrightness = debounce((value) => {
-            fetch('http://' + window.location.hostname + ':81/api/brightness', {
+            fetch('/api/brightness', {
                 method: 'POST',
                 headers: { 'Content-Type': 'application/json' },
                 body: JSON.stringify({ brightness: parseInt(value) })
@@ -1191,7 +1321,7 @@ private:
         const debouncedUpdateColor = debounce(() => {
             const hue = parseInt(document.getElementById('hue').value);
             const saturation = parseInt(document.getElementById('saturation').value);
-            fetch('http://' + window.location.hostname + ':81/api/color', {
+            fetch('/api/color', {
                 method: 'POST',
                 headers: { 'Content-Type': 'application/json' },
                 body: JSON.stringify({ hue, saturation })
@@ -1215,7 +1345,7 @@ private:
         }
 
         function updateLifeSpeed(speed) {
-            fetch('http://' + window.location.hostname + ':81/api/life-speed', {
+            fetch('/api/life-speed', {
                 method: 'POST',
                 headers: {
                     'Content-Type': 'application/json',
@@ -1231,7 +1361,7 @@ private:
         }
 
         function updateAutoRestart(enabled) {
-            fetch('http://' + window.location.hostname + ':81/api/life-auto-restart', {
+            fetch('/api/life-auto-restart', {
                 method: 'POST',
                 headers: {
                     'Content-Type': 'application/json',
@@ -1249,7 +1379,7 @@ private:
         function updateLifePattern() {
             isChangingLifePattern = true;
             
-            fetch('http://' + window.location.hostname + ':81/api/life-pattern', {
+            fetch('/api/life-pattern', {
                 method: 'POST',
                 headers: {
                     'Content-Type': 'application/json',
@@ -1302,7 +1432,7 @@ private:
         function updateFirePalette() {
             isChangingFirePalette = true;
             
-            fetch('http://' + window.location.hostname + ':81/api/fire-palette', {
+            fetch('/api/fire-palette', {
                 method: 'POST',
                 headers: {
                     'Content-Type': 'application/json',
@@ -1339,7 +1469,7 @@ private:
         function updateRainbowType() {
             isChangingRainbowType = true;
             
-            fetch('http://' + window.location.hostname + ':81/api/rainbow-type', {
+            fetch('/api/rainbow-type', {
                 method: 'POST',
                 headers: {
                     'Content-Type': 'application/json',
@@ -1547,7 +1677,7 @@ private:
 
         function toggleState() {
             const newState = !currentState.state;
-            fetch('http://' + window.location.hostname + ':81/api/state', {
+            fetch('/api/state', {
                 method: 'POST',
                 headers: {
                     'Content-Type': 'application/json',
@@ -1561,7 +1691,7 @@ private:
         }
 
         function updateEffect(value) {
-            fetch('http://' + window.location.hostname + ':81/api/effect', {
+            fetch('/api/effect', {
                 method: 'POST',
                 headers: {
                     'Content-Type': 'application/json',
@@ -1576,7 +1706,7 @@ private:
 
         // Inicialización
         function updateStatus() {
-            fetch('http://' + window.location.hostname + ':81/api/status')
+            fetch('/api/status')
                 .then(response => response.json())
                 .then(data => {
                     console.log('Data recibida:', data); // Debug completo
@@ -1707,6 +1837,74 @@ private:
             window.statusInterval = setInterval(updateStatus, interval);
         }
 
+        // Vista previa del framebuffer (ver preview_stream.h para el formato)
+        const PREVIEW_WIDTH = 27;
+        const PREVIEW_HEIGHT = 26;
+        const PREVIEW_LEDS = PREVIEW_WIDTH * PREVIEW_HEIGHT;
+        const previewPixels = new Uint8Array(PREVIEW_LEDS * 3);
+
+        function decodePreviewFrame(data) {
+            let pos = 2;
+            let led = 0;
+
+            if (data[0] === 0) { // Keyframe RLE
+                while (pos + 4 <= data.length && led < PREVIEW_LEDS) {
+                    const run = data[pos];
+                    for (let i = 0; i < run && led < PREVIEW_LEDS; i++, led++) {
+                        previewPixels.set(data.subarray(pos + 1, pos + 4), led * 3);
+                    }
+                    pos += 4;
+                }
+            } else if (data[0] === 1) { // Delta contra el frame anterior
+                while (pos + 2 <= data.length && led < PREVIEW_LEDS) {
+                    led += data[pos];
+                    const count = data[pos + 1];
+                    pos += 2;
+                    previewPixels.set(data.subarray(pos, pos + count * 3), led * 3);
+                    led += count;
+                    pos += count * 3;
+                }
+            } else if (data[0] === 2) { // Paleta de hasta 16 colores
+                const colors = data[2];
+                const palette = data.subarray(3, 3 + colors * 3);
+                pos = 3 + colors * 3;
+                for (led = 0; led < PREVIEW_LEDS; led++) {
+                    const packed = data[pos + (led >> 1)];
+                    const index = (led & 1) ? (packed >> 4) : (packed & 0x0F);
+                    previewPixels.set(palette.subarray(index * 3, index * 3 + 3), led * 3);
+                }
+            }
+        }
+
+        function drawPreview(ctx, image) {
+            for (let led = 0; led < PREVIEW_LEDS; led++) {
+                // Misma disposición en zigzag que xy() en led_manager.h; y = 0 es la base
+                const y = Math.floor(led / PREVIEW_WIDTH);
+                const column = led % PREVIEW_WIDTH;
+                const x = (y & 1) ? PREVIEW_WIDTH - 1 - column : column;
+                const dst = ((PREVIEW_HEIGHT - 1 - y) * PREVIEW_WIDTH + x) * 4;
+                image.data[dst] = previewPixels[led * 3];
+                image.data[dst + 1] = previewPixels[led * 3 + 1];
+                image.data[dst + 2] = previewPixels[led * 3 + 2];
+                image.data[dst + 3] = 255;
+            }
+            ctx.putImageData(image, 0, 0);
+        }
+
+        function initPreview() {
+            const canvas = document.getElementById('previewCanvas');
+            const ctx = canvas.getContext('2d');
+            const image = ctx.createImageData(PREVIEW_WIDTH, PREVIEW_HEIGHT);
+            const socket = new WebSocket('ws://' + window.location.host + '/ws/preview');
+            socket.binaryType = 'arraybuffer';
+
+            socket.onmessage = (event) => {
+                decodePreviewFrame(new Uint8Array(event.data));
+                requestAnimationFrame(() => drawPreview(ctx, image));
+            };
+            socket.onclose = () => setTimeout(initPreview, 2000);
+        }
+
         // En el DOMContentLoaded, solo llamar a las funciones
         document.addEventListener('DOMContentLoaded', function() {
             initRainbowSelector();
@@ -1723,6 +1921,7 @@ private:
             
             updateStatus();
             setUpdateInterval();
+            initPreview();
         });
     </script>
 </body>
@@ -1731,11 +1930,48 @@ private:
     }
 
 public:
-    WebManager(LedManager* ledMgr) : server(81), ledManager(ledMgr) {}
+    WebManager(LedManager* ledMgr) : server(HTTP_PORT), ledManager(ledMgr), previewStream(ledMgr), firmwareUpdater(ledMgr), dailyVerse(ledMgr) {}
+
+    // Se llama antes de reiniciar tras una subida de firmware
+    void onBeforeRestart(std::function<void()> callback) {
+        firmwareUpdater.onBeforeRestart(callback);
+    }
+
+    void setSettingsManager(SettingsManager* settingsMgr) {
+        settingsManager = settingsMgr;
+    }
+
+    void setNetworkTask(NetworkTask* task) {
+        networkTask = task;
+    }
+
+    // Manejador para rutas que no son de la interfaz (p. ej. la API de Alexa)
+    void setApiFallback(std::function<bool(AsyncWebServerRequest*)> handler) {
+        apiFallback = handler;
+    }
+
+    AsyncWebServer& getServer() {
+        return server;
+    }
 
     void begin() {
         setupRoutes();
+        previewStream.begin(server);
+        firmwareUpdater.begin(server);
+        dailyVerse.begin();
         server.begin();
+        BootTimeline::instance().mark(BOOT_WEB_READY);
+    }
+
+    void handle() {
+        firmwareUpdater.handle();
+
+        // Mientras el versículo recorre la matriz se mantiene al día: solo se
+        // avisa a la tarea del versículo, que descarga cuando venció
+        TextOverlay& overlay = ledManager->getOverlay();
+        if (overlay.isEnabled() && overlay.getSource() == OVERLAY_VERSE) {
+            dailyVerse.request();
+        }
     }
 };
 
@@ -0,0 +1,104 @@
+#ifndef WIFI_RECONNECT_H
+#define WIFI_RECONNECT_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Reconexión WiFi con espera exponencial, separada del driver: OTAManager
+// le avisa de los eventos de conexión y pregunta en cada vuelta si toca
+// otro intento. Nada aquí espera, así que la tarea que la atiende nunca se
+// bloquea mientras no hay red.
+class WifiReconnect {
+private:
+    unsigned long lastAttempt;
+    unsigned long reconnectDelay;
+    unsigned long disconnectedSince;
+    bool connected;
+
+    // Estadísticas de reconexión
+    uint32_t reconnectAttempts;
+    uint32_t reconnections;
+    unsigned long lastOutageDuration;
+    unsigned long longestOutageDuration;
+    unsigned long totalOutageDuration;
+
+public:
+    WifiReconnect()
+        : lastAttempt(0),
+          reconnectDelay(WIFI_RETRY_DELAY),
+          disconnectedSince(0),
+          connected(false),
+          reconnectAttempts(0),
+          reconnections(0),
+          lastOutageDuration(0),
+          longestOutageDuration(0),
+          totalOutageDuration(0) {}
+
+    // Primer intento de conexión, hecho por quien llama
+    void begin(unsigned long now) {
+        lastAttempt = now;
+        reconnectDelay = WIFI_RETRY_DELAY;
+    }
+
+    // La conexión quedó lista; true si venía de un corte
+    bool onConnected(unsigned long now) {
+        connected = true;
+        reconnectDelay = WIFI_RETRY_DELAY;
+        if (disconnectedSince == 0) return false;
+
+        lastOutageDuration = now - disconnectedSince;
+        totalOutageDuration += lastOutageDuration;
+        if (lastOutageDuration > longestOutageDuration) {
+            longestOutageDuration = lastOutageDuration;
+        }
+        reconnections++;
+        disconnectedSince = 0;
+        return true;
+    }
+
+    void onDisconnected(unsigned long now) {
+        connected = false;
+        disconnectedSince = max(now, 1UL);  // 0 = sin corte en curso
+        lastAttempt = now;
+        reconnectDelay = WIFI_RETRY_DELAY;
+    }
+
+    // true si hay que volver a llamar a WiFi.begin(); duplica la espera
+    bool retryDue(unsigned long now) {
+        if (connected || now - lastAttempt < reconnectDelay) return false;
+        lastAttempt = now;
+        reconnectAttempts++;
+        reconnectDelay = min(reconnectDelay * 2, WIFI_MAX_RETRY_DELAY);
+        return true;
+    }
+
+    bool isConnected() const {
+        return connected;
+    }
+
+    unsigned long getReconnectDelay() const {
+        return reconnectDelay;
+    }
+
+    uint32_t getReconnectAttempts() const {
+        return reconnectAttempts;
+    }
+
+    uint32_t getReconnections() const {
+        return reconnections;
+    }
+
+    unsigned long getLastOutageDuration() const {
+        return lastOutageDuration;
+    }
+
+    unsigned long getLongestOutageDuration() const {
+        return longestOutageDuration;
+    }
+
+    unsigned long getTotalOutageDuration() const {
+        return totalOutageDuration;
+    }
+};
+
+#endif